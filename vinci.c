@@ -27,48 +27,29 @@ boolean existing_files (char *basename, int *ext, int  *ine, int *d, int *m, int
    /* m and n, respectively. If an inconsistency in the dimensions is detected the      */
    /* return value is FALSE.                                                            */
 
-{  FILE    *fp;
-   char    filename [255], line [255], data_type [255];
-   boolean begin_found, return_value = TRUE;
-   int     local_d;
+{  char    filename [255];
+   boolean return_value = TRUE;
+   int     columns;
 
    *ext = *ine = NONE;
    *d = *m = *n = 0;
 
-   /* try to open the .ext-file */
+   /* read the header of the .ext-file; the files are read completely only later */
    sprintf (filename, "%s.ext", basename);
-   if ((fp = fopen (filename, "r")))
-   {  begin_found = FALSE;
-      while (!feof (fp) && !begin_found)
-      {  fgets (line, 255, fp);
-         if (!strncmp (line, "begin", 5)) begin_found = TRUE;
-      }
-      if (begin_found)
-      {  fscanf (fp, "%i %i %s ", n, d, data_type);
-         *ext = determine_data_type (data_type);
-      }
-      fclose (fp);
-   }
+   if (read_header (filename, n, &columns, ext))
+      *d = columns;
 
-   /* try to open the .ine-file */
+   /* read the header of the .ine-file */
    sprintf (filename, "%s.ine", basename);
-   if ((fp = fopen (filename, "r")))
-   {  begin_found = FALSE;
-      while (!feof (fp) && !begin_found)
-      {  fgets (line, 255, fp);
-         if (!strncmp (line, "begin", 5)) begin_found = TRUE;
-      }
-      if (begin_found)
-      {  fscanf (fp, "%i %i %s ", m, &local_d, data_type);
-         *ine = determine_data_type (data_type);
-         if ((*d > 0) && (*d != local_d))
-         {  *d = 0;
-            printf ("\nThe information about the dimension is contradictory in your .ext- and .ine-");
-            printf ("\nfiles. Please check the files and restart the programme.\n");
-            return_value = FALSE;
-         }
-      }
-      fclose (fp);
+   if (read_header (filename, m, &columns, ine))
+   {  if ((*d > 0) && (*d != columns))
+      {  *d = 0;
+         printf ("\nThe information about the dimension is contradictory in your .ext- and .ine-");
+         printf ("\nfiles. Please check the files and restart the programme.\n");
+         return_value = FALSE;
+      }
+      else
+         *d = columns;
    }
 
    return return_value;
@@ -80,18 +61,9 @@ boolean existing_files (char *basename, int *ext, int  *ine, int *d, int *m, int
 void existing_programmes (boolean *lrs)
    /* determines if the specified executables exist */
 
-{  FILE *fp;
-   char filename [255];
-
-   *lrs = FALSE;
-
-   /* search "lrs" */
-   sprintf (filename, "%s", LRS_EXEC);
-   if ((fp = fopen (filename, "rb")))
-   {  *lrs = TRUE;
-      fclose (fp);
-   }
-
+{
+   /* search "lrs" where "open_lrs" executes it */
+   *lrs = lrs_exists ();
 }
 
 /****************************************************************************************/
@@ -145,66 +117,73 @@ int method_proposal (int ext, int ine, boolean lrs, int d, int m, int n)
       return NONE;
    }
 
-      if (files_count == 1 && ext != NONE && !(lrs && ext != REAL_T))
-   {  printf ("\nActually no method can be applied; please install lrs or create the .ine");
-      printf ("\nfile.\n");
-      return NONE;
-   }
-
    printf ("\nThus the following methods can be applied (for a description of each method");
    printf ("\nplease read the manual):");
    if (files_count == 1)
       if (ext == NONE)
       {
          printf ("\n- rlass");
-         if (lrs)
-            printf ("\n- lawd");
+         printf ("\n- lawd");
+         printf ("\n- hot, hybrid, rch and lawnd, enumerating the vertices first");
       }
       else
       {
+         printf ("\n- hot, hybrid, rch, lawnd and lawd, computing the facets first");
          if (lrs && ext != REAL_T)
             printf ("\n- lrs, if the origin is in the interior of the polytope");
       }
    else
    {  printf ("\n- hot");
+      printf ("\n- hybrid");
       printf ("\n- rlass");
       printf ("\n- rch");
-      if (lrs)
-         printf ("\n- lawd");
+      printf ("\n- lawd");
       if (lrs && ext != REAL_T)
          printf ("\n- lrs, if the origin is in the interior of the polytope");
    }
 
    printf ("\n");
 
-   /* determine the method; if possible choose hot or rlass, otherwise lrs */
-   if (ext != NONE && ine != NONE)
+   /* determine the method; choose hot if the vertices are given, otherwise rlass */
+   if (ext != NONE)
    {  printf ("\nI recommend 'hot'.\n");
       return HOT;
    }
-   else if (ine != NONE)
+   else
    {  printf ("\nI recommend 'rlass'.\n");
       return RLASS;
    }
-   else /* only ext present */
-   {  printf ("\nThe only possible method is 'lrs'; note that it will fail if the origin does");
-      printf ("\nnot lie in the polytope interior!\n");
-      return LRS;
-   }
 
 }
 
 /****************************************************************************************/
 
+static boolean both_descriptions (char *method, int ext, int ine)
+   /* checks whether the vertices and the hyperplanes needed by the method can be       */
+   /* obtained, i.e. whether at least one of the two files exists, and tells which of   */
+   /* them are computed from the other one                                              */
+
+{
+   if (ext == NONE && ine == NONE)
+   {  printf ("\nTo use %s you need the vertex or the hyperplane file; the missing one is", method);
+      printf ("\ncomputed from the other one. However, none of them could be found. Please");
+      printf ("\ncreate one of them and rerun the programme.");
+      return FALSE;
+   }
+   else if (ext == NONE)
+      printf ("\nThe .ext-file could not be found; the vertices are enumerated first.");
+   else if (ine == NONE)
+      printf ("\nThe .ine-file could not be found; the facets are computed first.");
+   return TRUE;
+}
+
+/****************************************************************************************/
+
 boolean method_test (int method, int ext, int ine, boolean lrs, int d, int m, int n)
    /* The function tests if the chosen method can be run in the situation characterised */
    /* by the parameters which are the same as in 'method_proposal'.                     */
 
-{  int     files_count = 0;
-   boolean ok = TRUE;
-
-   if (ext != NONE) files_count++;
-   if (ine != NONE) files_count++;
+{  boolean ok = TRUE;
 
    switch (method)
    {
@@ -231,80 +210,28 @@ boolean method_test (int method, int ext, int ine, boolean lrs, int d, int m, in
       }
       break;
    case RCH:
-      if (ext == NONE || ine == NONE)
-      {  printf ("\nTo use 'rch' you need the vertex and the hyperplane file. However, ");
-         if (ext == NONE && ine == NONE)
-         {  printf ("none of them");
-            printf ("\ncould be found. Please create them and restart the programme.");
-         }
-         else if (ext == NONE)
-         {  printf ("the");
-            printf ("\n.ext-file could not be found. Please create it and rerun the programme.");
-         }
-         else
-         {  printf ("the");
-            printf ("\n.ine-file could not be found. Please create it and rerun the programme.");
-         }
-         ok = FALSE;
-      }
+      ok = both_descriptions ("'rch'", ext, ine);
       break;
    case HOT:
-      if (ext == NONE || ine == NONE)
-      {  printf ("\nTo use 'hot' you need the vertex and the hyperplane file. However, ");
-         if (ext == NONE && ine == NONE)
-         {  printf ("none of them could be found. Please create them and restart the");
-            printf ("\nprogramme.");
-         }
-         else if (ext == NONE)
-         {  printf ("the");
-            printf ("\n.ext-file could not be found. Please create it and rerun the programme.");
-         }
-         else
-         {  printf ("the");
-            printf ("\n.ine-file could not be found. Please create it and rerun the programme.");
-         }
-         ok = FALSE;
-      }
+   case HYBRID:
+      ok = both_descriptions ("'hot' or 'hybrid'", ext, ine);
       break;
    case LAWND:
-      if (files_count == 2)
-         printf ("\nWARNING: Be aware that 'lawnd' only works for non degenerate input data!");
-      else
-      {  printf ("\nTo use 'lawnd' you need the vertex and the hyperplane file. However, ");
-         if (files_count == 0)
-            printf ("\nnone of them could be found. Please create them and restart the programme.");
-         else
-         {
-            if (ext == NONE)
-            {  printf ("\nthe .ext-file could not be found. Please create it and rerun");
-               printf ("\nthe programme.");
-            }
-            else
-            {  printf ("\nthe .ine-file could not be found. Please create it and rerun");
-               printf ("\nthe programme.");
-            }
-            ok = FALSE;
-         }
-      }
+      ok = both_descriptions ("'lawnd'", ext, ine);
+      if (ok)
+         printf ("\nWARNING: Be aware that 'lawnd' is slow for highly degenerate input data!");
       break;
    case LAWD:
-      if (lrs && ine != NONE)
-      {  if (ine == REAL_T)
-         {  printf ("\n'lawd' can only be used for integer or rational data, not for floating");
-            printf ("\npoint data.");
-            ok = FALSE;
-         }
-      }
-      else
-      {  printf ("\nTo use the method 'lawd' you need to install lrs and to create the .ine-file.");
-         if (!lrs && ine == NONE)
-            printf ("\nDo so and restart the programme.");
-         else if (ine == NONE)
-            printf ("\nPlease create the inequality file and restart the programme.");
-         else
-            printf ("\nPlease install 'lrs' and run the programme again.");
+      if (ine == NONE && ext == NONE)
+      {  printf ("\nTo use the method 'lawd' you need to create the .ine-file or the .ext-file.");
+         printf ("\nPlease do so and restart the programme.");
          ok = FALSE;
       }
+      else if (!lrs || ine == NONE || ine == REAL_T)
+      {  printf ("\n'lrs' is not installed or cannot be used for this input; the vertices are");
+         printf ("\ntaken instead, and degenerate ones are perturbed.");
+         both_descriptions ("'lawd'", ext, ine);
+      }
       break;
    case RLASS:
       if (ine == NONE)
@@ -326,10 +253,11 @@ void print_methods (FILE *f)
    fprintf (f, "\nTo specify a volume computation method use the option '-m' followed by a");
    fprintf (f, "\nblank and one of the following codes:");
    fprintf (f, "\n\n- hot   for the hybrid orthonormalisation technique");
+   fprintf (f, "\n- hybrid for hot switching to Lasserre's scheme on suitable faces");
    fprintf (f, "\n- rlass for Lasserre's revised recursive scheme");
    fprintf (f, "\n- rch   for revised Cohen-Hickey-Triangulation");
-   fprintf (f, "\n- lawd  for Lawrence's formula in the general case using 'lrs'");
-   fprintf (f, "\n- lawnd for Lawrence's formula in the non degenerate case");
+   fprintf (f, "\n- lawd  for Lawrence's formula in the general case using 'lrs' if installed");
+   fprintf (f, "\n- lawnd for Lawrence's formula with perturbed degenerate vertices");
    fprintf (f, "\n- lrs   for boundary triangulation via 'lrs'");
    fprintf (f, "\n\nIf no method is specified, the programme tries to find an optimal algorithm.");
 }
@@ -360,6 +288,36 @@ void print_help (FILE *f)
    fprintf (f, "\n%s", T18);
    fprintf (f, "\n%s", T19);
    fprintf (f, "\n%s", T20);
+   fprintf (f, "\n%s", T21);
+   fprintf (f, "\n%s", T22);
+   fprintf (f, "\n%s", T23);
+   fprintf (f, "\n%s", T24);
+   fprintf (f, "\n%s", T25);
+   fprintf (f, "\n%s", T26);
+   fprintf (f, "\n%s", T27);
+   fprintf (f, "\n%s", T28);
+   fprintf (f, "\n%s", T29);
+   fprintf (f, "\n%s", T30);
+   fprintf (f, "\n%s", T31);
+   fprintf (f, "\n%s", T32);
+   fprintf (f, "\n%s", T33);
+   fprintf (f, "\n%s", T34);
+   fprintf (f, "\n%s", T35);
+   fprintf (f, "\n%s", T36);
+   fprintf (f, "\n%s", T37);
+   fprintf (f, "\n%s", T38);
+   fprintf (f, "\n%s", T39);
+   fprintf (f, "\n%s", T40);
+   fprintf (f, "\n%s", T41);
+   fprintf (f, "\n%s", T42);
+   fprintf (f, "\n%s", T43);
+   fprintf (f, "\n%s", T44);
+   fprintf (f, "\n%s", T45);
+   fprintf (f, "\n%s", T46);
+   fprintf (f, "\n%s", T47);
+   fprintf (f, "\n%s", T48);
+   fprintf (f, "\n%s", T49);
+   fprintf (f, "\n%s", T50);
 }
 
 /****************************************************************************************/
@@ -409,6 +367,8 @@ boolean determine_method (char *choice, int *method)
       *method = RCH;
    else if (!strcmp (choice, "hot"))
       *method = HOT;
+   else if (!strcmp (choice, "hybrid"))
+      *method = HYBRID;
    else if (!strcmp (choice, "lawd"))
       *method = LAWD;
    else if (!strcmp (choice, "lawnd"))
@@ -426,14 +386,43 @@ boolean determine_method (char *choice, int *method)
 
 /****************************************************************************************/
 
+boolean determine_order (char *choice)
+   /* tries to determine the desired ordering strategy from the contents of choice and  */
+   /* to store it in G_Order. If this is successfully done, TRUE is returned and FALSE  */
+   /* otherwise.                                                                        */
+
+{  boolean ok = TRUE;
+
+   if      (!strcmp (choice, "degeneracy"))
+      G_Order = ORDER_DEGENERACY;
+   else if (!strcmp (choice, "lex"))
+      G_Order = ORDER_LEX;
+   else if (!strcmp (choice, "hilbert"))
+      G_Order = ORDER_HILBERT;
+   else if (!strcmp (choice, "facets"))
+      G_Order = ORDER_FACETS;
+   else if (!strcmp (choice, "auto"))
+      G_Order = ORDER_AUTO;
+   else
+   {  ok = FALSE;
+      printf ("\nThe ordering strategy '%s' does not exist. Please use one of 'degeneracy',", choice);
+      printf ("\n'lex', 'hilbert', 'facets' or 'auto'.");
+   }
+   return ok;
+}
+
+/****************************************************************************************/
+
 boolean evaluate_parameters (int argc, char *argv [], char *filename, int *method)
    /* The function tries to determine the parameter values and consequently sets the    */
    /* filename, the desired method and the global variable "precomp". If an error oc-   */
    /* curs which forces the programme to break the return value is FALSE.               */
 
-{  boolean filename_chosen = FALSE, ok = TRUE;
+{  boolean filename_chosen = FALSE, ok = TRUE, symmetry = FALSE;
    int     index = 1;
       /* points to the actually considered entry of the parameter list */
+   static char symmetryfile [255], dumpfile [255], trifile [255], samplefile [255],
+               cachefile [255], extfile [255], inefile [255];
 
    *method = NONE;
    G_Storage = -1;
@@ -441,13 +430,18 @@ boolean evaluate_parameters (int argc, char *argv [], char *filename, int *metho
    while (index < argc && ok)
    {  /* analyse entry "index" of argv */
 
-      if (argv [index] [0] != '-')
-      {  /* this must be the file name */
+      if (argv [index] [0] != '-' || !strcmp (argv [index], "-"))
+      {  /* this must be the file name, "-" standing for the standard input */
          if (filename_chosen)
          {  printf ("\nThere seem to be two file names in your command line, '%s'", filename);
             printf ("\nand '%s'. Please check this again.", argv [index]);
             ok = FALSE;
          }
+         else if (strlen (argv [index]) >= 255 - 4)
+         {  /* the extensions ".ext", ".ine" and ".vpb" are appended in "main" */
+            printf ("\nThe file name '%s' is too long.", argv [index]);
+            ok = FALSE;
+         }
          else
          {  filename_chosen = TRUE;
             strcpy (filename, argv [index]);
@@ -472,6 +466,164 @@ boolean evaluate_parameters (int argc, char *argv [], char *filename, int *metho
          }
       }
 
+      else if (!strcmp (argv [index], "-o"))
+      {  if (G_Order != -1)
+         {  printf ("\nYou specified the option '-o' twice. Please decide for one of them.");
+            ok = FALSE;
+         }
+         else if (index + 1 >= argc)
+         {  printf ("\nYou used the option '-o' without anything following. Please use one of");
+            printf ("\n'degeneracy', 'lex', 'hilbert', 'facets' or 'auto'.");
+            ok = FALSE;
+         }
+         else
+         {  ok = determine_order (argv [index + 1]);
+            index += 2;
+         }
+      }
+
+      else if (!strncmp (argv [index], "--dump-faces=", 13))
+      {  if (strlen (argv [index]) == 13)
+         {  printf ("\nYou specified the option '--dump-faces=' without a file name.");
+            ok = FALSE;
+         }
+         else
+         {  strcpy (dumpfile, argv [index] + 13);
+            G_DumpFile = dumpfile;
+            index++;
+         }
+      }
+
+      else if (!strncmp (argv [index], "--dump-dim=", 11))
+      {  G_DumpDim = atoi (argv [index] + 11);
+         if (G_DumpDim < 1)
+         {  printf ("\nThe option '--dump-dim=' must be followed by a positive integer.");
+            ok = FALSE;
+         }
+         index++;
+      }
+
+      else if (!strncmp (argv [index], "--write-triangulation=", 22))
+      {  if (strlen (argv [index]) == 22)
+         {  printf ("\nYou specified the option '--write-triangulation=' without a file name.");
+            ok = FALSE;
+         }
+         else
+         {  strcpy (trifile, argv [index] + 22);
+            G_TriangulationFile = trifile;
+            index++;
+         }
+      }
+
+      else if (!strncmp (argv [index], "--sample=", 9))
+      {  if (strlen (argv [index]) == 9)
+         {  printf ("\nYou specified the option '--sample=' without a file name.");
+            ok = FALSE;
+         }
+         else
+         {  strcpy (samplefile, argv [index] + 9);
+            G_SampleFile = samplefile;
+            index++;
+         }
+      }
+
+      else if (!strncmp (argv [index], "--sample-size=", 14))
+      {  G_SampleSize = atol (argv [index] + 14);
+         if (G_SampleSize < 1)
+         {  printf ("\nThe option '--sample-size=' must be followed by a positive integer.");
+            ok = FALSE;
+         }
+         index++;
+      }
+
+      else if (!strncmp (argv [index], "--moments=", 10))
+      {  G_Moments = atoi (argv [index] + 10);
+         if (G_Moments < 1)
+         {  printf ("\nThe option '--moments=' must be followed by a positive integer.");
+            ok = FALSE;
+         }
+         index++;
+      }
+
+      else if (!strncmp (argv [index], "--cache-file=", 13))
+      {  if (strlen (argv [index]) == 13)
+         {  printf ("\nYou specified the option '--cache-file=' without a file name.");
+            ok = FALSE;
+         }
+         else
+         {  strcpy (cachefile, argv [index] + 13);
+            G_CacheFile = cachefile;
+            index++;
+         }
+      }
+
+      else if (!strncmp (argv [index], "--cache-mem=", 12))
+      {  G_CacheMemory = atol (argv [index] + 12);
+         if (G_CacheMemory < 1)
+         {  printf ("\nThe option '--cache-mem=' must be followed by a positive integer.");
+            ok = FALSE;
+         }
+         index++;
+      }
+
+      else if (!strncmp (argv [index], "--write-ext=", 12))
+      {  if (strlen (argv [index]) == 12)
+         {  printf ("\nYou specified the option '--write-ext=' without a file name.");
+            ok = FALSE;
+         }
+         else
+         {  strcpy (extfile, argv [index] + 12);
+            G_ExtFile = extfile;
+            index++;
+         }
+      }
+
+      else if (!strncmp (argv [index], "--write-ine=", 12))
+      {  if (strlen (argv [index]) == 12)
+         {  printf ("\nYou specified the option '--write-ine=' without a file name.");
+            ok = FALSE;
+         }
+         else
+         {  strcpy (inefile, argv [index] + 12);
+            G_IneFile = inefile;
+            index++;
+         }
+      }
+
+      else if (!strncmp (argv [index], "--precision=", 12))
+      {  if (!strcmp (argv [index] + 12, "double"))
+            G_Precision = PRECISION_DOUBLE;
+         else if (!strcmp (argv [index] + 12, "dd"))
+            G_Precision = PRECISION_DD;
+         else if (!strcmp (argv [index] + 12, "quad") && quad_available ())
+            G_Precision = PRECISION_QUAD;
+         else
+         {  printf ("\nThe precision '%s' does not exist. Please use one of 'double', 'dd'",
+                    argv [index] + 12);
+            if (quad_available ())
+               printf ("\nor 'quad'.");
+            else
+               printf ("\n('quad' is not supported by the compiler).");
+            ok = FALSE;
+         }
+         index++;
+      }
+
+      else if (!strcmp (argv [index], "--convert"))
+      {  G_Convert = TRUE;
+         index++;
+      }
+
+      else if (!strcmp (argv [index], "--session"))
+      {  G_Session = TRUE;
+         index++;
+      }
+
+      else if (!strcmp (argv [index], "-y"))
+      {  symmetry = TRUE;
+         index++;
+      }
+
       else if (strlen (argv [index]) >= 2 && argv [index] [1] == 's')
       {
          if (strlen (argv [index]) == 2)
@@ -504,6 +656,24 @@ boolean evaluate_parameters (int argc, char *argv [], char *filename, int *metho
          }
       }
 
+      else if (strlen (argv [index]) >= 2 && argv [index] [1] == 'k')
+      {  G_Objectives = atoi (argv [index] + 2);
+         if (G_Objectives < 1)
+         {  printf ("\nThe option '-k' must be directly followed by a positive integer, e. g. '-k4'.");
+            ok = FALSE;
+         }
+         index++;
+      }
+
+      else if (strlen (argv [index]) >= 2 && argv [index] [1] == 't')
+      {  G_Threads = atoi (argv [index] + 2);
+         if (G_Threads < 1)
+         {  printf ("\nThe option '-t' must be directly followed by a positive integer, e. g. '-t4'.");
+            ok = FALSE;
+         }
+         index++;
+      }
+
       else
       {  printf ("\nYou specified the option '%s' which does not exist. The following text provides", argv [index]);
          printf ("\nsome help on how to use the programme.\n");
@@ -516,6 +686,10 @@ boolean evaluate_parameters (int argc, char *argv [], char *filename, int *metho
    if (ok)
    {  if (G_Storage == -1)
          G_Storage = DEFAULT_STORAGE;
+      if (G_Order == -1)
+         G_Order = DEFAULT_ORDER;
+      if (G_SampleSize == -1)
+         G_SampleSize = DEFAULT_SAMPLE_SIZE;
 
       if (!filename_chosen)
       {  printf ("\nYou did not specify any file name, so I suppose that you are not familiar with");
@@ -524,6 +698,33 @@ boolean evaluate_parameters (int argc, char *argv [], char *filename, int *metho
          print_help (stdout);
          ok = FALSE;
       }
+      else if (symmetry)
+      {  sprintf (symmetryfile, "%s.sym", filename);
+         G_SymmetryFile = symmetryfile;
+      }
+      if (G_DumpDim > 0 && G_DumpFile == NULL)
+      {  printf ("\nThe option '--dump-dim' is only meaningful together with '--dump-faces'.");
+         ok = FALSE;
+      }
+      if (G_SampleSize != DEFAULT_SAMPLE_SIZE && G_SampleFile == NULL)
+      {  printf ("\nThe option '--sample-size' is only meaningful together with '--sample'.");
+         ok = FALSE;
+      }
+      if (G_Session && (G_DumpFile != NULL || G_SymmetryFile != NULL))
+      {  printf ("\nIn the session mode neither face volumes are dumped nor symmetries exploited.");
+         G_DumpFile = NULL;
+         G_SymmetryFile = NULL;
+      }
+      if (G_Session && (G_CacheFile != NULL || G_CacheMemory >= 0))
+      {  printf ("\nIn the session mode all face volumes are kept in memory; the options");
+         printf ("\n'--cache-file' and '--cache-mem' are ignored.");
+         G_CacheFile = NULL;
+         G_CacheMemory = -1;
+      }
+      if (G_DumpFile != NULL && G_Order == ORDER_FACETS)
+      {  printf ("\nThe hyperplanes are not reordered when face volumes are dumped.");
+         G_Order = ORDER_DEGENERACY;
+      }
    }
 
    return ok;
@@ -532,19 +733,247 @@ boolean evaluate_parameters (int argc, char *argv [], char *filename, int *metho
 
 /****************************************************************************************/
 
+static void compute_volume (int method, int ext, int ine, boolean lrs, int d, int m, int n,
+   char *vertexfile, char *planesfile)
+   /* proposes or tests the method for the polytope described by the parameters as in   */
+   /* 'method_proposal', computes its volume and prints it together with the time used  */
+   /* since the previous call                                                           */
+
+{  boolean        ok;
+   rational       volume;
+   char           rational_volume [255];
+   int            i;
+   struct tms     time_info;
+   static clock_t used = 0;
+
+   if (G_Session && method != HOT)
+   {  if (method != NONE)
+         printf ("\nThe session mode is based on 'hot', which is used instead.");
+      method = HOT;
+   }
+
+   if (method == NONE)
+   {  printf ("\nYou did not specify any method; let us analyse the situation.\n");
+      method = method_proposal (ext, ine, lrs, d, m, n);
+   }
+   else
+   {  ok = method_test (method, ext, ine, lrs, d, m, n);
+      if (!ok)
+      {  method = NONE;
+         printf ("\nAlternatively let us analyse what can be done in the present situation.\n");
+         method_proposal (ext, ine, lrs, d, m, n);
+      }
+   }
+
+   if (method == NONE)
+      printf ("\n\n");
+   else
+   {
+
+      printf ("\n_______________________________________________________________________________\n");
+
+      if (G_DumpFile != NULL && method != HOT && method != HYBRID)
+      {  printf ("\nFace volumes can only be dumped with 'hot' and 'hybrid'; the option");
+         printf ("\n'--dump-faces' is ignored.");
+         G_DumpFile = NULL;
+      }
+      if ((G_CacheFile != NULL || G_CacheMemory >= 0) && method != HOT
+          && method != HYBRID)
+      {  printf ("\nThe face volumes can only be cached by 'hot' and 'hybrid'; the options");
+         printf ("\n'--cache-file' and '--cache-mem' are ignored.");
+         G_CacheFile = NULL;
+         G_CacheMemory = -1;
+      }
+      if (G_TriangulationFile != NULL && method != RCH)
+      {  printf ("\nThe triangulation can only be written with 'rch'; the option");
+         printf ("\n'--write-triangulation' is ignored.");
+         G_TriangulationFile = NULL;
+      }
+      if (G_SampleFile != NULL && method != RCH)
+      {  printf ("\nPoints can only be sampled with 'rch'; the option '--sample' is");
+         printf ("\nignored.");
+         G_SampleFile = NULL;
+      }
+      if (G_ExtFile != NULL
+          && (ext != NONE || method == RLASS || method == LRS
+              || (method == LAWD && lrs && ine != NONE && ine != REAL_T)))
+      {  printf ("\nThe vertices are only written when they are enumerated from the .ine-file;");
+         printf ("\nthe option '--write-ext' is ignored.");
+         G_ExtFile = NULL;
+      }
+      if (G_IneFile != NULL
+          && (ine != NONE || method == RLASS || method == LRS))
+      {  printf ("\nThe hyperplanes are only written when they are computed from the .ext-file;");
+         printf ("\nthe option '--write-ine' is ignored.");
+         G_IneFile = NULL;
+      }
+      if (G_Precision != PRECISION_DOUBLE && method != LAWND && method != LAWD)
+      {  printf ("\nOnly Lawrence's formula is evaluated in extended precision; the option");
+         printf ("\n'--precision' is ignored.");
+         G_Precision = PRECISION_DOUBLE;
+      }
+      if (G_Moments > 0 && method != RCH)
+      {  printf ("\nMoments can only be computed with 'rch'; the option '--moments' is");
+         printf ("\nignored.");
+         G_Moments = -1;
+      }
+
+      switch (method)
+      {
+      case RCH:
+         printf ("\nUsing revised Cohen-Hickey-triangulation for computing the volume.");
+         print_pivoting (stdout, method);
+         printf ("\n");
+         volume_ch_file (&volume, vertexfile, planesfile);
+         break;
+      case HOT:
+         printf ("\nUsing the hybrid orthonormalisation technique.");
+         printf ("\nThe storage level is set to %i.", G_Storage);
+         print_pivoting (stdout, method);
+         printf ("\n");
+         if (G_Session)
+            volume_session_file (&volume, vertexfile, planesfile);
+         else
+            volume_ortho_file (&volume, vertexfile, planesfile);
+         break;
+      case HYBRID:
+         printf ("\nUsing the hybrid orthonormalisation technique, switching to Lasserre's");
+         printf ("\nrevised recursive scheme on suitable faces.");
+         printf ("\nThe storage level is set to %i.", G_Storage);
+         print_pivoting (stdout, method);
+         printf ("\n");
+         volume_hybrid_file (&volume, vertexfile, planesfile);
+         break;
+      case LAWND:
+         printf ("\nUsing Lawrence's formula with perturbed degenerate vertices for computing ");
+         printf ("\nthe volume.");
+         printf ("\nThe random seed is set to %i.", G_RandomSeed);
+         if (G_Objectives > 1)
+            printf ("\n%i objective functions are tried.", G_Objectives);
+         if (G_Threads > 1)
+            printf ("\nThe formula is evaluated by %i threads.", G_Threads);
+         if (G_Precision == PRECISION_DD)
+            printf ("\nThe summands are computed in double-double precision where needed.");
+         else if (G_Precision == PRECISION_QUAD)
+            printf ("\nThe summands are computed in quadruple precision where needed.");
+         print_pivoting (stdout, method);
+         printf ("\n");
+         volume_lawrence_file (&volume, vertexfile, planesfile);
+         break;
+      case LAWD:
+         if (lrs && ine != NONE && ine != REAL_T)
+            printf ("\nUsing 'lrs' and Lawrence's formula for computing the volume.");
+         else
+         {  printf ("\nUsing Lawrence's formula with perturbed degenerate vertices for computing ");
+            printf ("\nthe volume.");
+         }
+         printf ("\nThe random seed is set to %i.", G_RandomSeed);
+         if (G_Objectives > 1)
+            printf ("\n%i objective functions are tried.", G_Objectives);
+         if (G_Threads > 1)
+            printf ("\nThe formula is evaluated by %i threads.", G_Threads);
+         if (G_Precision == PRECISION_DD)
+            printf ("\nThe summands are computed in double-double precision where needed.");
+         else if (G_Precision == PRECISION_QUAD)
+            printf ("\nThe summands are computed in quadruple precision where needed.");
+         print_pivoting (stdout, method);
+         printf ("\n");
+         if (lrs && ine != NONE && ine != REAL_T)
+            volume_lawrence_lrs_file (&volume, planesfile);
+         else
+            volume_lawrence_file (&volume, vertexfile, planesfile);
+         break;
+      case RLASS:
+         printf ("\nUsing Lasserre's revised recursive scheme for computing the volume");
+         printf ("\nThe storage level is set to %i.", G_Storage);
+         print_pivoting (stdout, method);
+         printf ("\n");
+         volume_lasserre_file (&volume, planesfile);
+         break;
+      case LRS:
+         printf ("\nUsing 'lrs' for computing a boundary triangulation.\n");
+         volume_lrs_file (&volume, rational_volume, vertexfile);
+         break;
+      }
+
+      times (&time_info);
+
+      printf ("\n_______________________________________________________________________________");
+#ifdef STATISTICS
+      print_statistics (stdout, method);
+      printf ("\n_______________________________________________________________________________");
+#endif
+
+#ifdef RATIONAL
+      printf ("\n\nVolume: ");
+      cout << volume;
+#else
+      if (method != LRS)
+         printf ("\n\nVolume: %20.12e", volume);
+      else
+      {  printf ("\n\nVolume: ");
+         for (i = 0; i < strlen (rational_volume) - 1; i++)
+            printf ("%c", rational_volume [i]);
+         if (strpbrk (rational_volume, "/") != NULL)
+            printf (" = %20.12e", volume);
+      }
+
+#endif
+
+      printf ("\n\nTime passed with computation: %8.1f s\n",
+              ((double) (time_info.tms_utime - used)) / ((double) CLOCKS_PER_SEC));
+      used = time_info.tms_utime;
+      printf ("_______________________________________________________________________________\n\n");
+
+   }
+}
+
+/****************************************************************************************/
+
+static void volumes_standard_input (int method)
+   /* computes the volumes of all polytopes given one after the other on the standard  */
+   /* input as described for 'read_polytope_buffer'                                    */
+
+{  char       *buffer;
+   const char *s, *end;
+   long int   size;
+   int        ext, ine, d, m, n, count = 0, storage = G_Storage;
+
+   if (G_Session || G_Convert)
+   {  printf ("\nThe session mode and the option '--convert' need files; they cannot be used");
+      printf ("\nwith the standard input.\n\n");
+      return;
+   }
+
+   buffer = read_whole_file (stdin, &size);
+   end = buffer + size;
+   s = read_polytope_buffer (buffer, end, "stdin", &ext, &ine, &d, &m, &n);
+   if (s == NULL)
+      printf ("\nThe standard input does not contain any polytope.\n\n");
+   while (s != NULL)
+   {  count++;
+      printf ("\nPolytope %i of the standard input:", count);
+      /* Lasserre's method lowers the storage level to the dimension of the polytope. */
+      G_Storage = storage;
+      /* lrs needs the files */
+      compute_volume (method, ext, ine, FALSE, d, m, n, "-", "-");
+      s = read_polytope_buffer (s, end, "stdin", &ext, &ine, &d, &m, &n);
+   }
+   my_free (buffer, size + 1);
+}
+
+/****************************************************************************************/
+
 int main (int argc, char *argv [])
 
-{  char       filename [255];
+{  char       filename [255 - 4];
+      /* leaves room for the extensions, which are four characters long */
    int        method = NONE;
    boolean    ok;
-   char       vertexfile [255], planesfile [255];
-   rational   volume;
-   char       rational_volume [255];
+   char       vertexfile [255], planesfile [255], binaryfile [255];
    int        ext, ine;
    boolean    lrs;
    int        d, m, n;
-   int        i;
-   struct tms time_info;
 
 
    printf ("\n                       VINCI - Version %s as of %s\n", VERSION, VERSION_DATE);
@@ -556,109 +985,37 @@ int main (int argc, char *argv [])
 
    if (!ok)
       printf ("\n\n");
+   else if (!strcmp (filename, "-"))
+      volumes_standard_input (method);
    else
    {
       sprintf (vertexfile, "%s.ext", filename);
       sprintf (planesfile, "%s.ine", filename);
+      sprintf (binaryfile, "%s.vpb", filename);
 
-      ok = existing_files (filename, &ext, &ine, &d, &m, &n);
+      if (!G_Convert
+          && open_binary (binaryfile, vertexfile, planesfile, &ext, &ine, &d, &m, &n))
+      {  G_BinaryFile = binaryfile;
+         printf ("\nThe polytope is read from the binary file '%s'.", binaryfile);
+      }
+      else
+         ok = existing_files (filename, &ext, &ine, &d, &m, &n);
       existing_programmes (&lrs);
+      if (G_BinaryFile != NULL)
+         lrs = FALSE; /* lrs needs the text files */
 
-      if (ok)
-      {
-         if (method == NONE)
-         {  printf ("\nYou did not specify any method; let us analyse the situation.\n");
-            method = method_proposal (ext, ine, lrs, d, m, n);
-         }
-         else
-         {  ok = method_test (method, ext, ine, lrs, d, m, n);
-            if (!ok)
-            {  method = NONE;
-               printf ("\nAlternatively let us analyse what can be done in the present situation.\n");
-               method_proposal (ext, ine, lrs, d, m, n);
-            }
-         }
-
-         if (method == NONE)
-            printf ("\n\n");
+      if (ok && G_Convert)
+      {  if (ext == NONE && ine == NONE)
+            printf ("\nNeither the .ext- nor the .ine-file could be found; nothing is converted.\n\n");
          else
-         {
-
-            printf ("\n_______________________________________________________________________________\n");
-
-            switch (method)
-            {
-            case RCH:
-               printf ("\nUsing revised Cohen-Hickey-triangulation for computing the volume.");
-               print_pivoting (stdout, method);
-               printf ("\n");
-               volume_ch_file (&volume, vertexfile, planesfile);
-               break;
-            case HOT:
-               printf ("\nUsing the hybrid orthonormalisation technique.");
-               printf ("\nThe storage level is set to %i.", G_Storage);
-               print_pivoting (stdout, method);
-               printf ("\n");
-               volume_ortho_file (&volume, vertexfile, planesfile);
-               break;
-            case LAWND:
-               printf ("\nUsing Lawrence's formula in the non-degenerate case for computing ");
-               printf ("\nthe volume.");
-               printf ("\nThe random seed is set to %i.", G_RandomSeed);
-               print_pivoting (stdout, method);
-               printf ("\n");
-               volume_lawrence_file (&volume, vertexfile, planesfile);
-               break;
-            case LAWD:
-               printf ("\nUsing 'lrs' and Lawrence's formula for computing the volume.");
-               printf ("\nThe random seed is set to %i.", G_RandomSeed);
-               print_pivoting (stdout, method);
-               printf ("\n");
-               volume_lawrence_lrs_file (&volume, planesfile);
-               break;
-            case RLASS:
-               printf ("\nUsing Lasserre's revised recursive scheme for computing the volume");
-               printf ("\nThe storage level is set to %i.", G_Storage);
-               print_pivoting (stdout, method);
-               printf ("\n");
-               volume_lasserre_file (&volume, planesfile);
-               break;
-            case LRS:
-               printf ("\nUsing 'lrs' for computing a boundary triangulation.\n");
-               volume_lrs_file (&volume, rational_volume, vertexfile);
-               break;
-            }
-
-            times (&time_info);
-
-            printf ("\n_______________________________________________________________________________");
-#ifdef STATISTICS
-            print_statistics (stdout, method);
-            printf ("\n_______________________________________________________________________________");
-#endif
-
-#ifdef RATIONAL
-            printf ("\n\nVolume: ");
-            cout << volume;
-#else
-            if (method != LRS)
-               printf ("\n\nVolume: %20.12e", volume);
-            else
-            {  printf ("\n\nVolume: ");
-               for (i = 0; i < strlen (rational_volume) - 1; i++)
-                  printf ("%c", rational_volume [i]);
-               if (strpbrk (rational_volume, "/") != NULL)
-                  printf (" = %20.12e", volume);
-            }
-
-#endif
-
-            printf ("\n\nTime passed with computation: %8.1f s\n",
-                    ((double) time_info.tms_utime) / ((double) CLOCKS_PER_SEC));
-            printf ("_______________________________________________________________________________\n\n");
-
+         {  read_polytope (vertexfile, planesfile);
+            write_binary (binaryfile, (ext == NONE ? REAL_T : ext), (ine == NONE ? REAL_T : ine),
+                          hash_polytope (vertexfile, planesfile));
+            printf ("\nThe polytope has been written to '%s'.\n\n", binaryfile);
          }
       }
+      else if (ok)
+         compute_volume (method, ext, ine, lrs, d, m, n, vertexfile, planesfile);
    }
 
    return TRUE;
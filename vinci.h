@@ -44,7 +44,37 @@
 #define T17 "   up certain methods considerably while needing more storage space."
 #define T18 "-r directly followed by an integer. The value sets the random seed used for"
 #define T19 "   determining the objective function for Lawrence's formula."
-#define T20 "\nFor more information please consult the manual."
+#define T20 "-t directly followed by a positive integer. The value sets the number of"
+#define T21 "   threads used by 'lawnd' and 'lawd' and for reading the input files."
+#define T22 "-k directly followed by a positive integer. Lawrence's formula is evaluated"
+#define T23 "   for so many objective functions, and the least cancelling one is chosen."
+#define T24 "--precision=dd or --precision=quad to compute the summands of Lawrence's"
+#define T25 "   formula in double-double or quadruple precision where double is not enough."
+#define T26 "-o followed by the strategy for ordering the vertices for 'hot', 'hybrid' and"
+#define T27 "   'rch': 'degeneracy', 'lex', 'hilbert', 'facets' or 'auto'."
+#define T28 "-y to exploit symmetries of the polytope with 'hot', 'hybrid' and 'rlass'; they"
+#define T29 "   are detected among the signed permutations of the coordinates and read"
+#define T30 "   from the file with extension '.sym', if it exists."
+#define T31 "--dump-faces=file to write the volumes of the faces computed by 'hot' or"
+#define T32 "   'hybrid' to the file, and --dump-dim=k to compute and write all faces of"
+#define T33 "   dimension at least k."
+#define T34 "--session to keep the polytope in memory after computing its volume with 'hot'"
+#define T35 "   and to modify it by the commands 'add', 'remove' and 'move' from stdin."
+#define T36 "--write-triangulation=file to write the simplices of 'rch' to the file."
+#define T37 "--sample=file to write points sampled uniformly from the simplices of 'rch'"
+#define T38 "   to the file, and --sample-size=N to choose their number; the seed is set"
+#define T39 "   by -r."
+#define T40 "--moments=p to integrate all monomials up to degree p with 'rch' and to output"
+#define T41 "   them together with the centroid."
+#define T42 "--cache-mem=MB to bound the memory of the face volumes stored by 'hot' and"
+#define T43 "   'hybrid', and --cache-file=file to spill those not recently used to the file."
+#define T44 "--write-ext=file to write the vertices to the file when they are enumerated"
+#define T45 "   because the .ext-file does not exist."
+#define T46 "--write-ine=file to write the facets to the file when they are computed"
+#define T47 "   because the .ine-file does not exist."
+#define T48 "--convert to write the polytope to the binary file 'file.vpb', which is read"
+#define T49 "   instead of the .ext- and .ine-files by later runs."
+#define T50 "\nFor more information please consult the manual."
 
 /****************************************************************************************/
 
@@ -60,6 +90,8 @@
 
 #define LRS_EXEC      "lrs"
    /* location of external programme with path                                        */
+#define GZIP_EXEC     "gzip"
+   /* programme decompressing input files compressed by gzip                          */
 
 #define PIVOTING 1
 #define MIN_PIVOT 0.5
@@ -77,11 +109,43 @@
    /*     chosen, MIN_PIVOT is ignored. If total pivoting is not possible (e. g. for    */
    /*     solving linear equations) partial pivoting is performed.                      */
 
+#define DIRECT_FACES 3
+   /* Faces of dimension 2 up to DIRECT_FACES are not split up any further by 'rch' and */
+   /* 'hot'; instead their volume is evaluated directly in their own affine hull, by   */
+   /* ordering the vertices of polygons cyclically. The value may be at most 3; a       */
+   /* value of 1 switches the direct evaluation off.                                    */
+
+#define HYBRID_BIAS 2
+   /* The method 'hybrid' hands a face with n vertices and f facets in dimension d to   */
+   /* Lasserre's method if HYBRID_BIAS * f^2 * d * (d-1)! < n * m, where m is the total */
+   /* number of hyperplanes. n * m and f^2 * d estimate the work per face of the        */
+   /* recursion and of Lasserre's method; the latter stores no intermediate volumes for */
+   /* the faces handed to it and thus reaches subfaces along up to (d-1)! paths. Higher */
+   /* values favour the recursion.                                                      */
+
 #define DEFAULT_STORAGE 20
    /* For so many recursion levels intermediate volumes are stored, starting from the   */
    /* level with two planes fixed. The value is only active if no option -s is speci-   */
    /* fied; it may be set to 0, for instance, by using the option -s0.                  */
 
+#define DEFAULT_ORDER ORDER_DEGENERACY
+   /* The strategy for ordering vertices and hyperplanes in 'hot', 'hybrid' and 'rch'   */
+   /* if no option -o is specified; see "renumber_vertices".                            */
+
+#define DEFAULT_SAMPLE_SIZE 1000000
+   /* The number of points sampled with the option --sample if no option --sample-size */
+   /* is specified.                                                                     */
+
+#define DEFAULT_CACHE_MEMORY 1024
+   /* The number of megabytes the tree of face volumes of 'hot' and 'hybrid' may occupy */
+   /* when a cache file is given by --cache-file, but no option --cache-mem.            */
+
+#define LAWRENCE_ACCURACY 1e-14
+   /* With the option --precision, 'lawnd' recomputes the summands of a vertex in       */
+   /* extended precision if their estimated rounding error in double precision exceeds  */
+   /* LAWRENCE_ACCURACY times the absolute value of the sum divided by the number of     */
+   /* vertices; smaller values lead to more vertices being recomputed.                  */
+
 #define STATISTICS
    /* If STATISTICS is defined, during volume computation, some statistical variables   */
    /* like the number of simplices and their volume distribution are withheld.          */
@@ -102,7 +166,38 @@
    /* with hot for ccp6. Therefore, we define a separate constant for the incidence     */
    /* computation.                                                                      */
 #define ARRAYSIZESTEP 5
-                          /* the dynamic arrays are increased in steps of this size */
+                          /* the dynamic arrays are increased at least by this size */
+#define ARENASIZE 4096
+                          /* initial size in bytes of the memory block of an arena */
+#define SYMMETRY_EPSILON 1e-8
+                          /* tolerance for matching the images of points under symmetries */
+#define SYMMETRY_GENERATORS 1000
+                          /* maximal number of generators of the symmetry group */
+#define HILBERT_BITS 16
+                          /* bits per coordinate for the Hilbert curve ordering, */
+                          /* at most the number of bits of an unsigned int */
+#define MATRIX_ALIGN 32
+                          /* alignment in bytes of the rows of matrices */
+#define SAMPLE_BATCH 4096
+                          /* number of sampled points buffered before writing them */
+#define TRIANGULATION_BUFFER 4096
+                          /* number of simplices buffered before writing them to a file */
+#define LRS_BATCH 4096
+                          /* number of cobases read from lrs before evaluating them */
+#define CACHE_SLOTS 65536
+                          /* initial number of slots of the cache file; a power of 2 */
+#define INCIDENCE_CACHE 100000000
+                          /* minimal value of G_n * G_m * G_d for which the incidence */
+                          /* is stored in a file with extension '.icb' for later runs */
+#define STREAM_BUFFER 1048576
+                          /* size in bytes of the buffer through which compressed input */
+                          /* files are read */
+#define LEX_EPSILON 1e-6
+                          /* relative tolerance for the pivot elements when degenerate */
+                          /* vertices are split by 'lawnd' */
+#define DD_EPSILON 1e-9
+                          /* tolerance of the double description method for normalised */
+                          /* constraints and rays */
 
 #define CLOCKS_PER_SEC 100
                           /* defines the number of clock ticks per second returned by   */
@@ -123,10 +218,24 @@
 #define LAWND 10
 #define RLASS 11
 #define LRS   12
+#define HYBRID 13
+
+#define ORDER_DEGENERACY 1 /* constants for the vertex and hyperplane orders */
+#define ORDER_LEX        2
+#define ORDER_HILBERT    3
+#define ORDER_FACETS     4
+#define ORDER_AUTO       5
+
+#define PRECISION_DOUBLE 0 /* constants for the precision of Lawrence's formula */
+#define PRECISION_DD     1
+#define PRECISION_QUAD   2
 
 #define KEY_VERTICES   2  /* constants for the key type actually used in the balanced   */
 #define KEY_PLANES_VAR 3  /* tree routines                                              */
 
+#define HASH_START 2166136261UL
+   /* the initial value of the 32 bit hash values computed by 'hash_memory'            */
+
 #ifdef STATISTICS
 #define STAT_SMALLEST_EXP -200
 #define STAT_BIGGEST_EXP 200
@@ -181,6 +290,25 @@ struct T_VertexSuperset
 typedef struct T_VertexSuperset T_VertexSuperset;
 
 
+/* An arena is a bump allocator for data which is needed only during one recursion     */
+/* step, like the faces already examined in this step. All its memory is released at   */
+/* once when the step is finished. If the current block is exhausted, a further one is */
+/* chained in front of it; on clearing, the chain is replaced by a single block of the */
+/* total size, so that after a few steps every step is served from one block.          */
+struct T_ArenaBlock
+       {struct T_ArenaBlock *next; /* the previously used block, if any             */
+        long int            size;  /* the number of bytes usable in this block      */
+        long int            used;  /* the number of bytes already handed out        */
+       };                          /* the usable bytes follow the header directly    */
+typedef struct T_ArenaBlock T_ArenaBlock;
+
+struct T_Arena
+       {T_ArenaBlock *block;      /* the block from which memory is handed out       */
+        long int     total;       /* the summed sizes of all blocks in the chain     */
+       };
+typedef struct T_Arena T_Arena;
+
+
 /* Types for storing face volumes in balanced trees. For storing and retrieving a key   */
 /* is needed for every face; all possibilities for keys are defined by the union T_Key. */
 /* Only one of the keys is active at a time. T_Tree defines the tree itself.            */
@@ -200,6 +328,8 @@ typedef union T_Key T_Key;
 struct T_Tree
        {struct T_Tree *tree_l, *tree_r; /* the left and right subtrees */
         int           tree_b;
+        boolean       tree_u;           /* whether the node has been looked up since the */
+                                        /* tree was last shrunk, see 'vinci_cache'        */
         T_Key         key;
         rational      vol;              /* the stored volume */
        };
@@ -226,6 +356,43 @@ extern T_VertexSet G_Vertices;
 extern int G_Storage;
    /* see the annotations for DEFAULT_STORAGE                                           */
 extern int G_RandomSeed;
+extern int G_Threads;
+   /* number of threads evaluating Lawrence's formula in 'lawnd' and 'lawd'            */
+extern int G_Objectives;
+   /* number of random objective functions for Lawrence's formula                      */
+extern int G_Precision;
+   /* precision of the summands of Lawrence's formula, one of the PRECISION constants  */
+extern int G_Order;
+   /* see the annotations for DEFAULT_ORDER                                             */
+extern char *G_DumpFile;
+   /* name of the file to which 'hot' writes the face volumes, or NULL                  */
+extern int G_DumpDim;
+   /* if positive, all faces of at least this dimension are written to G_DumpFile      */
+extern char *G_SymmetryFile;
+   /* name of the file with additional symmetries if symmetries are to be exploited,   */
+   /* NULL otherwise                                                                    */
+extern boolean G_Session;
+   /* whether the polytope is modified by commands from stdin after the computation     */
+extern char *G_TriangulationFile;
+   /* name of the file to which 'rch' writes its simplices, or NULL                     */
+extern char *G_SampleFile;
+   /* name of the file to which 'rch' writes uniformly sampled points, or NULL          */
+extern long int G_SampleSize;
+   /* see the annotations for DEFAULT_SAMPLE_SIZE                                       */
+extern int G_Moments;
+   /* if positive, 'rch' integrates all monomials up to this degree                     */
+extern char *G_CacheFile;
+   /* name of the file to which face volumes of 'hot' are spilled, or NULL              */
+extern long int G_CacheMemory;
+   /* megabytes the tree of face volumes of 'hot' may occupy, or -1 for no limit        */
+extern char *G_ExtFile;
+   /* name of the file to which enumerated vertices are written, or NULL                */
+extern char *G_IneFile;
+   /* name of the file to which computed facets are written, or NULL                    */
+extern char *G_BinaryFile;
+   /* name of the binary file from which the polytope is read, or NULL                  */
+extern boolean G_Convert;
+   /* whether the .ext- and .ine-files are only converted into a binary file            */
 extern rational G_Minus1;
    /* dummy to have a pointer, namely &G_Minus1, to the value -1 */
 
@@ -261,7 +428,9 @@ extern rational G_Minus1;
 void *my_malloc (long int size);
 void *my_realloc (void *pointer, long int new_size, long int size_diff);
 void my_free (void *pointer, long int size);
+void account_memory (long int size_diff);
 T_Vertex *create_vertex ();
+T_Vertex *create_mapped_vertex (real *coords);
 void free_vertex (T_Vertex *v);
 void create_hyperplanes ();
 void free_hyperplanes ();
@@ -280,6 +449,10 @@ void free_int_vector (int *v, int n);
 rational **create_matrix (int m, int n);
 void redim_matrix (rational ***A, int m_alt, int m_neu, int n);
 void free_matrix (rational **A, int m, int n);
+T_Arena *create_arenas ();
+void free_arenas (T_Arena *arena);
+void *arena_malloc (T_Arena *arena, long int size);
+void clear_arena (T_Arena *arena);
 void create_key (T_Key *key, int key_choice);
 void free_key (T_Key key, int key_choice);
 #ifdef STATISTICS
@@ -289,6 +462,7 @@ void free_statistics ();
 #endif
 void tree_out (T_Tree **ppr , boolean *pi_balance, T_Key key, rational **volume,
    T_Key **keyfound, int key_choice);
+void free_tree (T_Tree *tree, int key_choice);
 void add_hypervar (T_LassInt hyperplane, T_LassInt variable, T_Key *key);
 void delete_hypervar (T_LassInt hyperplane, T_LassInt variable, T_Key *key);
 
@@ -301,6 +475,7 @@ void free_set (T_VertexSet s);
 void free_set_and_vertices (T_VertexSet s);
 void clear_set (T_VertexSet *s);
 T_VertexSet duplicate_set (T_VertexSet s);
+T_VertexSet duplicate_set_in_arena (T_Arena *arena, T_VertexSet s);
 void copy_set (T_VertexSet s1, T_VertexSet *s2);
 void renumber_vertices ();
 rational normalise_vertices ();
@@ -316,6 +491,7 @@ void free_superset (T_VertexSuperset **S);
 void print_superset (FILE *f, T_VertexSuperset *S);
 boolean is_in_superset (T_VertexSet s, T_VertexSuperset *S);
 void add_superelement (T_VertexSuperset **S, T_VertexSet s);
+void add_superelement_in_arena (T_Arena *arena, T_VertexSuperset **S, T_VertexSet s);
 
 /****************************************************************************************/
 /*                  functions and procedures from 'vinci_computation'                   */
@@ -326,22 +502,86 @@ rational det_and_invert (rational **A, int rows, int columns, boolean verbose);
 void simplex_volume (T_VertexSet S, rational *volume, boolean verbose);
 rational add_orthonormal (int d, T_VertexSet face, rational **H, T_Vertex *vertex);
 rational orthonormal (int d, T_VertexSet face, rational **H);
+void apply_householder (int d, rational **H, rational *x);
+void local_coordinates (int d, rational **H, T_Vertex *origin, T_Vertex *vertex,
+   rational *x);
+int init_moments (int p);
+void free_moments ();
+int * monomial_exponents (int k);
+void simplex_moments (T_VertexSet S, rational volume, rational *moments);
+void run_jobs (void *(*f) (void *), void *job, size_t size, int threads);
 
 /****************************************************************************************/
 /*                     functions and procedures from 'vinci_volume'                     */
 /****************************************************************************************/
 
+void tri_ortho (int d, rational *V);
 void volume_ch_file (rational *volume, char *vertexfile, char *planesfile);
 void volume_ortho_file (rational *volume, char *vertexfile, char *planesfile);
+void volume_hybrid_file (rational *volume, char *vertexfile, char *planesfile);
 void volume_lawrence_file (rational *volume, char *vertexfile, char *planesfile);
 void volume_lawrence_lrs_file (rational *volume, char *planesfile);
 void volume_lrs_file (rational *volume, char *rational_volume, char *vertexfile);
+void volume_session_file (rational *volume, char *vertexfile, char *planesfile);
 
 /****************************************************************************************/
 /*                 functions and procedures from 'vinci_lass'                           */
 /****************************************************************************************/
 
 void volume_lasserre_file (rational *volume, char *planesfile);
+rational volume_lasserre (rational *A, int m, int d);
+void free_lasserre ();
+
+/****************************************************************************************/
+/*                  functions and procedures from 'vinci_symmetry'                      */
+/****************************************************************************************/
+
+int compute_symmetries (char *filename, rational *fixed);
+int * orbit_weights ();
+int plane_representative (int k);
+rational * symmetry_centre ();
+void canonical_face (T_VertexSet face, T_VertexSet *canon);
+void free_symmetries ();
+
+/****************************************************************************************/
+/*                     functions and procedures from 'vinci_dd'                         */
+/****************************************************************************************/
+
+int dd_vertices (real **planes, int m, rational ***vertices);
+
+/****************************************************************************************/
+/*                      functions and procedures from 'vinci_hull'                      */
+/****************************************************************************************/
+
+int convex_hull (real **points, int n, real ***planes, boolean *extreme);
+
+/****************************************************************************************/
+/*                     functions and procedures from 'vinci_binary'                     */
+/****************************************************************************************/
+
+void write_binary (char *filename, int ext, int ine, unsigned long int source);
+boolean open_binary (char *filename, char *vertexfile, char *planesfile, int *ext, int *ine,
+   int *d, int *m, int *n);
+void binary_vertices ();
+void binary_hyperplanes ();
+boolean binary_incidence ();
+boolean in_binary_file (void *pointer);
+boolean read_incidence (char *filename, unsigned long int hash);
+void write_incidence (char *filename, unsigned long int hash);
+
+/****************************************************************************************/
+/*                   functions and procedures from 'vinci_cache'                        */
+/****************************************************************************************/
+
+void create_cache ();
+void cache_added (T_Tree **tree, T_Key key, rational *volume);
+void free_cache ();
+
+/****************************************************************************************/
+/*                   functions and procedures from 'vinci_sample'                       */
+/****************************************************************************************/
+
+void sample_points (char *filename, long int count, int *simplex, rational *volume, int n);
 
 /****************************************************************************************/
 /*                   functions and procedures from 'vinci_screen'                       */
@@ -355,6 +595,17 @@ void print_matrix (FILE *f, rational **A, int m, int n);
    void print_statistics (FILE *f, int method);
 #endif
 
+/****************************************************************************************/
+/*                   functions and procedures from 'vinci_precision'                    */
+/****************************************************************************************/
+
+boolean quad_available ();
+void *create_extended_work ();
+void free_extended_work (void *work);
+void extended_summands (real **normal, real *x, real *c, real c0, real *hi, real *lo,
+   boolean *failed, void *work);
+void extended_add (real *hi, real *lo, real b_hi, real b_lo);
+
 /****************************************************************************************/
 /*                   functions and procedures from 'vinci_file'                         */
 /****************************************************************************************/
@@ -362,8 +613,21 @@ void print_matrix (FILE *f, rational **A, int m, int n);
 FILE * open_read (char *filename);
 int determine_data_type (char *data_type);
 void sread_rational_value (char *s, rational *value);
+boolean read_header (char *filename, int *rows, int *columns, int *data_type);
 void read_vertices (char *filename);
 void read_hyperplanes (char *filename);
+const char *read_polytope_buffer (const char *s, const char *end, char *name, int *ext,
+   int *ine, int *d, int *m, int *n);
+char *read_whole_file (FILE *f, long int *size);
 void compute_incidence ();
+void write_vertices (char *filename);
+void write_hyperplanes (char *filename);
+void read_polytope (char *vertexfile, char *planesfile);
+boolean lrs_exists ();
+FILE * open_lrs (char *filename, char *head, char *tail);
+boolean close_lrs (FILE *f);
+unsigned long int hash_memory (const char *s, long int size, unsigned long int hash);
+unsigned long int hash_file (char *filename);
+unsigned long int hash_polytope (char *vertexfile, char *planesfile);
 
 /****************************************************************************************/
@@ -0,0 +1,388 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                   vinci_binary.c                                     */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* Authors: Benno Bueeler (bueeler@ifor.math.ethz.ch)                                   */
+/*          and                                                                         */
+/*          Andreas Enge (enge@ifor.math.ethz.ch)                                       */
+/*          Institute for Operations Research                                           */
+/*	    Swiss Federal Institute of Technology Zurich                                */
+/*	    Switzerland                                                                 */
+/*                                                                                      */
+/* Last Changes: October 19, 2026                                                       */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* a binary file format holding the vertices, the hyperplanes and their incidence, and  */
+/* a file holding only the incidence                                                    */
+/*                                                                                      */
+/****************************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+   /* for the memory mapping */
+
+#include "vinci.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* A binary file starts with the header below, followed by the G_n * G_d coordinates of */
+/* the vertices, the G_m * (G_d + 1) entries of G_Hyperplanes, both row by row as       */
+/* doubles, and optionally the incidence as G_n rows of (G_m + 7) / 8 bytes, the bit   */
+/* j % 8 of byte j / 8 of row i being set if vertex i lies in hyperplane j. The header  */
+/* has 64 bytes, so that the doubles are aligned. The file is mapped privately into     */
+/* memory, and the coordinates and hyperplanes are used in place; pages modified by the */
+/* computation are copied by the operating system, the file itself is never changed.   */
+/* The mapping is kept until the end of the programme.                                  */
+
+#define BINARY_MAGIC "VINCIVPB"
+#define BINARY_VERSION 1
+#define BINARY_BYTE_ORDER 0x01020304
+   /* written in the byte order of the machine, it detects files from a different one */
+#define BINARY_INCIDENCE 1
+   /* flag for a stored incidence */
+
+typedef struct
+        {char         magic [8];
+         unsigned int version, byte_order, d, n, m, ext, ine, flags, hash, source;
+            /* ext and ine are the data types of the files the polytope was converted   */
+            /* from and source is their hash value given by 'hash_polytope'; hash is    */
+            /* the FNV-1a hash value of everything following the header                 */
+         real         epsilon;
+            /* the value of INCIDENCE_EPSILON with which the incidence was computed     */
+         unsigned int padding [2];
+        } T_BinaryHeader;
+
+typedef char T_BinaryHeaderCheck [sizeof (T_BinaryHeader) == 64 ? 1 : -1];
+   /* fails to compile if the header does not have 64 bytes */
+
+#define INCIDENCE_MAGIC "VINCIIC1"
+
+typedef struct
+        {char         magic [8];
+         unsigned int hash, n, m, padding;
+            /* hash is the value passed to 'write_incidence' */
+         real         epsilon;
+        } T_IncidenceHeader;
+   /* header of a file holding only the incidence, which follows in the same format as */
+   /* in the binary file                                                               */
+
+typedef char T_IncidenceHeaderCheck [sizeof (T_IncidenceHeader) == 32 ? 1 : -1];
+
+static char           *binary = NULL;
+static size_t         binary_size;
+static T_BinaryHeader *header;
+   /* the mapped file and its header */
+
+/****************************************************************************************/
+
+static long int incidence_bytes ()
+   /* returns the number of bytes of a row of the stored incidence */
+
+{
+   return (G_m + 7) / 8;
+}
+
+/****************************************************************************************/
+
+static void pack_incidence (int i, unsigned char *row)
+   /* stores the incidence of vertex i in the bits of row */
+
+{  int j;
+
+   memset (row, 0, incidence_bytes ());
+   for (j = 0; j < G_m; j++)
+      if (G_Incidence [i] [j])
+         row [j / 8] |= 1 << (j % 8);
+}
+
+/****************************************************************************************/
+
+static void unpack_incidence (const unsigned char *row)
+   /* creates G_Incidence from the G_n rows of bits starting at row */
+
+{  int i, j;
+
+   create_incidence ();
+   for (i = 0; i < G_n; i++, row += incidence_bytes ())
+      for (j = 0; j < G_m; j++)
+         G_Incidence [i] [j] = ((row [j / 8] >> (j % 8)) & 1);
+}
+
+/****************************************************************************************/
+
+static void write_block (FILE *f, char *filename, const void *s, long int size,
+   unsigned long int *hash)
+   /* writes the bytes to f and continues the hash value with them */
+
+{
+   if ((long int) fwrite (s, 1, size, f) != size)
+   {  fprintf (stderr, "\n***** ERROR: Could not write to file '%s' in 'write_binary'.\n",
+              filename);
+      exit (0);
+   }
+   *hash = hash_memory ((const char *) s, size, *hash);
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
+
+void write_binary (char *filename, int ext, int ine, unsigned long int source)
+   /* writes G_Vertices, G_Hyperplanes and G_Incidence to the specified file in the     */
+   /* binary format; ext and ine are the data types of the original files and source   */
+   /* is their hash value                                                               */
+
+{  FILE           *f;
+   T_BinaryHeader h;
+   unsigned char  *row;
+   int            i, j;
+   unsigned long  hash = HASH_START;
+
+   if (! (f = fopen (filename, "wb")))
+   {  fprintf (stderr, "\n***** ERROR: Could not open file '%s' in 'write_binary'.\n",
+              filename);
+      exit (0);
+   }
+   memset (&h, 0, sizeof (T_BinaryHeader));
+   memcpy (h.magic, BINARY_MAGIC, 8);
+   h.version = BINARY_VERSION;
+   h.byte_order = BINARY_BYTE_ORDER;
+   h.d = G_d;
+   h.n = G_n;
+   h.m = G_m;
+   h.ext = ext;
+   h.ine = ine;
+   h.source = source;
+   h.flags = BINARY_INCIDENCE;
+   h.epsilon = INCIDENCE_EPSILON;
+   /* the header is written again when the hash value is known */
+   fwrite (&h, sizeof (T_BinaryHeader), 1, f);
+
+   for (i = 0; i < G_n; i++)
+      write_block (f, filename, G_Vertices.loe [i] -> coords, G_d * sizeof (real), &hash);
+   for (j = 0; j < G_m; j++)
+      write_block (f, filename, G_Hyperplanes [j], (G_d + 1) * sizeof (real), &hash);
+   row = (unsigned char *) my_malloc (incidence_bytes ());
+   for (i = 0; i < G_n; i++)
+   {  pack_incidence (i, row);
+      write_block (f, filename, row, incidence_bytes (), &hash);
+   }
+   my_free (row, incidence_bytes ());
+
+   h.hash = hash;
+   if (fseek (f, 0, SEEK_SET) != 0 || fwrite (&h, sizeof (T_BinaryHeader), 1, f) != 1)
+   {  fprintf (stderr, "\n***** ERROR: Could not write to file '%s' in 'write_binary'.\n",
+              filename);
+      exit (0);
+   }
+   fclose (f);
+}
+
+/****************************************************************************************/
+
+boolean open_binary (char *filename, char *vertexfile, char *planesfile, int *ext, int *ine,
+   int *d, int *m, int *n)
+   /* maps the specified binary file into memory and checks it; the variables are set  */
+   /* as by 'existing_files'. Returns FALSE if the file does not exist or if it has     */
+   /* been converted from other files than the present vertex and planes file; if      */
+   /* neither of them exists, the binary file is used anyway.                           */
+
+{  int               fd;
+   struct stat       status;
+   long int          size;
+   unsigned long int source;
+
+   if ((fd = open (filename, O_RDONLY)) < 0)
+      return FALSE;
+   if (fstat (fd, &status) != 0 || status.st_size < (off_t) sizeof (T_BinaryHeader))
+   {  fprintf (stderr, "\n***** ERROR: The file '%s' in 'open_binary' is too short.\n",
+              filename);
+      exit (0);
+   }
+   binary_size = status.st_size;
+   binary = (char *) mmap (NULL, binary_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+   close (fd);
+   if (binary == (char *) MAP_FAILED)
+   {  fprintf (stderr, "\n***** ERROR: Could not map the file '%s' in 'open_binary'.\n",
+              filename);
+      exit (0);
+   }
+   header = (T_BinaryHeader *) binary;
+
+   if (memcmp (header -> magic, BINARY_MAGIC, 8) || header -> version != BINARY_VERSION
+       || header -> byte_order != BINARY_BYTE_ORDER)
+   {  fprintf (stderr, "\n***** ERROR: The file '%s' in 'open_binary' is not a binary ",
+              filename);
+      fprintf (stderr, "polytope file\nof version %i for this machine.\n", BINARY_VERSION);
+      exit (0);
+   }
+   size = sizeof (T_BinaryHeader)
+          + ((long int) header -> n * header -> d
+             + (long int) header -> m * (header -> d + 1)) * sizeof (real);
+   if (header -> flags & BINARY_INCIDENCE)
+      size += (long int) header -> n * ((header -> m + 7) / 8);
+   if ((long int) binary_size != size
+       || hash_memory (binary + sizeof (T_BinaryHeader), size - sizeof (T_BinaryHeader),
+                       HASH_START) != header -> hash)
+   {  fprintf (stderr, "\n***** ERROR: The file '%s' in 'open_binary' is corrupted.\n",
+              filename);
+      exit (0);
+   }
+
+   source = hash_polytope (vertexfile, planesfile);
+   if (source != 0 && source != header -> source)
+   {  printf ("\nThe binary file '%s' does not belong to the present .ext- and .ine-files;",
+              filename);
+      printf ("\nit is ignored.");
+      munmap (binary, binary_size);
+      binary = NULL;
+      return FALSE;
+   }
+
+   *ext = header -> ext;
+   *ine = header -> ine;
+   *d = header -> d + 1;
+   *m = header -> m;
+   *n = header -> n;
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+void binary_vertices ()
+   /* sets G_Vertices, G_n and G_d from the binary file opened by 'open_binary'; the   */
+   /* coordinates remain in the file                                                   */
+
+{  int      i;
+   T_Vertex *v;
+   real     *coords = (real *) (binary + sizeof (T_BinaryHeader));
+
+   G_d = header -> d;
+   G_n = header -> n;
+   G_Vertices = create_empty_set ();
+   for (i = 0; i < G_n; i++)
+   {  v = create_mapped_vertex (coords + (long int) i * G_d);
+      v -> no = i;
+      add_element (&G_Vertices, v);
+   }
+}
+
+/****************************************************************************************/
+
+void binary_hyperplanes ()
+   /* sets G_Hyperplanes, G_m and G_d from the binary file opened by 'open_binary'; the */
+   /* rows remain in the file                                                           */
+
+{  int  j;
+   real *rows = (real *) (binary + sizeof (T_BinaryHeader))
+                + (long int) header -> n * header -> d;
+
+   G_d = header -> d;
+   G_m = header -> m;
+   G_Hyperplanes = (real **) my_malloc (G_m * sizeof (real *));
+   for (j = 0; j < G_m; j++)
+      G_Hyperplanes [j] = rows + (long int) j * (G_d + 1);
+}
+
+/****************************************************************************************/
+
+boolean binary_incidence ()
+   /* creates G_Incidence from the binary file opened by 'open_binary'; returns FALSE  */
+   /* if the file contains no incidence computed with the current INCIDENCE_EPSILON    */
+
+{
+   if (!(header -> flags & BINARY_INCIDENCE) || header -> epsilon != INCIDENCE_EPSILON)
+      return FALSE;
+
+   unpack_incidence ((unsigned char *) (binary + sizeof (T_BinaryHeader))
+                     + ((long int) G_n * G_d + (long int) G_m * (G_d + 1)) * sizeof (real));
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+boolean in_binary_file (void *pointer)
+   /* checks whether the pointer points into the mapped binary file, in which case the  */
+   /* memory must not be freed                                                          */
+
+{
+   return (binary != NULL && (char *) pointer >= binary
+           && (char *) pointer < binary + binary_size);
+}
+
+/****************************************************************************************/
+
+boolean read_incidence (char *filename, unsigned long int hash)
+   /* creates G_Incidence from the specified incidence file if it has been written by  */
+   /* 'write_incidence' with the same hash value, G_n, G_m and INCIDENCE_EPSILON;       */
+   /* returns FALSE otherwise                                                           */
+
+{  int               fd;
+   struct stat       status;
+   char              *s;
+   T_IncidenceHeader *h;
+   boolean           ok;
+
+   if ((fd = open (filename, O_RDONLY)) < 0)
+      return FALSE;
+   if (fstat (fd, &status) != 0
+       || status.st_size != (off_t) (sizeof (T_IncidenceHeader)
+                                     + (long int) G_n * incidence_bytes ()))
+   {  close (fd);
+      return FALSE;
+   }
+   s = (char *) mmap (NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close (fd);
+   if (s == (char *) MAP_FAILED)
+      return FALSE;
+
+   h = (T_IncidenceHeader *) s;
+   ok = (!memcmp (h -> magic, INCIDENCE_MAGIC, 8) && h -> hash == hash
+         && h -> n == (unsigned int) G_n && h -> m == (unsigned int) G_m
+         && h -> epsilon == INCIDENCE_EPSILON);
+   if (ok)
+      unpack_incidence ((unsigned char *) (s + sizeof (T_IncidenceHeader)));
+   munmap (s, status.st_size);
+   return ok;
+}
+
+/****************************************************************************************/
+
+void write_incidence (char *filename, unsigned long int hash)
+   /* writes G_Incidence to the specified incidence file, together with the hash value */
+   /* identifying the polytope; since the file only saves time, nothing is written if  */
+   /* it cannot be created                                                             */
+
+{  FILE              *f;
+   T_IncidenceHeader h;
+   unsigned char     *row;
+   int               i;
+   boolean           ok;
+
+   if (! (f = fopen (filename, "wb")))
+      return;
+   memset (&h, 0, sizeof (T_IncidenceHeader));
+   memcpy (h.magic, INCIDENCE_MAGIC, 8);
+   h.hash = hash;
+   h.n = G_n;
+   h.m = G_m;
+   h.epsilon = INCIDENCE_EPSILON;
+   ok = (fwrite (&h, sizeof (T_IncidenceHeader), 1, f) == 1);
+
+   row = (unsigned char *) my_malloc (incidence_bytes ());
+   for (i = 0; i < G_n && ok; i++)
+   {  pack_incidence (i, row);
+      ok = ((long int) fwrite (row, 1, incidence_bytes (), f) == incidence_bytes ());
+   }
+   my_free (row, incidence_bytes ());
+
+   if (fclose (f) != 0 || !ok)
+      /* an incomplete file would only be rejected later */
+      remove (filename);
+}
+
+/****************************************************************************************/
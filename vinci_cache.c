@@ -0,0 +1,325 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                    vinci_cache.c                                     */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* Authors: Benno Bueeler (bueeler@ifor.math.ethz.ch)                                   */
+/*          and                                                                         */
+/*          Andreas Enge (enge@ifor.math.ethz.ch)                                       */
+/*          Institute for Operations Research                                           */
+/*	    Swiss Federal Institute of Technology Zurich                                */
+/*	    Switzerland                                                                 */
+/*                                                                                      */
+/* Last Changes: October 19, 2026                                                       */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* bounding the tree of face volumes of 'hot' and spilling it to a memory-mapped file   */
+/*                                                                                      */
+/****************************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+   /* for ftruncate, fileno and the memory mapping */
+
+#include "vinci.h"
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* The memory used by the nodes of the tree of face volumes is accounted for. When it   */
+/* exceeds G_CacheMemory megabytes, the tree is traversed; the volumes which have not   */
+/* been looked up since the previous traversal are written to the cache file (if any)   */
+/* and removed from the tree, which is then rebuilt in perfect balance from the         */
+/* remaining nodes. If this does not free half of the memory, all volumes are moved.    */
+/* Nodes whose volume is still being computed stay in place, so that the pointers held  */
+/* by the recursion remain valid.                                                       */
+/* The cache file is a hash table with linear probing. Each slot contains the volume,   */
+/* the dimension of the face and its vertex set as a bit vector over the vertex         */
+/* numbers; an empty slot has dimension 0. The table is doubled when it is half full.   */
+
+typedef struct
+        {rational vol;
+         int      d;
+        } T_CacheSlot;
+   /* the head of a slot in the cache file, followed by the bit vector */
+
+static long int  budget, memory, nodes;
+   /* the memory limit in bytes, the memory used by the tree and its number of nodes */
+static T_Tree    **node;
+   /* the nodes kept during a traversal, in their order in the tree */
+static long int  kept;
+   /* their number */
+static FILE      *cache_file = NULL;
+static char      *table;
+   /* the mapped hash table */
+static long int  slots, used, slot_size;
+   /* the number of slots, the number of them in use and the size of a slot in bytes */
+static int       words;
+   /* the number of words of the bit vectors */
+static char      *record;
+   /* buffer for building a slot */
+static long int  spilled, retrieved;
+   /* statistics */
+
+/****************************************************************************************/
+
+static long int node_size (T_Key key)
+   /* returns the memory occupied by the node of the tree with the given key; its set  */
+   /* has been created by "duplicate_set" and has as many entries as elements          */
+
+{
+   return sizeof (T_Tree) + (key.vertices.set.lastel + 1) * sizeof (T_Vertex *);
+}
+
+/****************************************************************************************/
+
+static void map_table (long int size)
+   /* maps the first size bytes of the cache file */
+
+{
+   table = (char *) mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                          fileno (cache_file), 0);
+   if (table == (char *) MAP_FAILED)
+   {  fprintf (stderr, "\n***** ERROR: Could not map the file '%s' in 'map_table'.\n",
+               G_CacheFile);
+      exit (0);
+   }
+}
+
+/****************************************************************************************/
+
+static void resize_file (long int size)
+   /* sets the size of the cache file to size bytes */
+
+{
+   fflush (cache_file);
+   if (ftruncate (fileno (cache_file), size) != 0)
+   {  fprintf (stderr, "\n***** ERROR: Could not enlarge the file '%s' in 'resize_file'.\n",
+               G_CacheFile);
+      exit (0);
+   }
+}
+
+/****************************************************************************************/
+
+static void build_record (T_Key key, rational volume)
+   /* writes the slot corresponding to the key and the volume into record */
+
+{  unsigned int *bits = (unsigned int *) (record + sizeof (T_CacheSlot));
+   int          i, no;
+
+   /* the padding is cleared since the whole slot is hashed and compared */
+   memset (record, 0, slot_size);
+   memcpy (record, &volume, sizeof (rational));
+   memcpy (record + sizeof (rational), &(key.vertices.d), sizeof (int));
+   for (i = 0; i <= key.vertices.set.lastel; i++)
+   {  no = key.vertices.set.loe [i] -> no;
+      bits [no / 32] |= 1u << (no % 32);
+   }
+}
+
+/****************************************************************************************/
+
+static long int find_slot (char *t, long int size, char *r)
+   /* returns the slot of the table t with size slots which contains the key of the     */
+   /* record r, or the empty slot where it is to be inserted. The hash value is the     */
+   /* Fowler-Noll-Vo function of the dimension and the bit vector.                      */
+
+{  unsigned long int hash;
+   long int          s;
+   T_CacheSlot       head;
+
+   hash = hash_memory (r + sizeof (rational), slot_size - sizeof (rational), HASH_START);
+
+   for (s = hash & (size - 1);; s = (s + 1) & (size - 1))
+   {  memcpy (&head, t + s * slot_size, sizeof (T_CacheSlot));
+      if (head.d == 0
+          || !memcmp (t + s * slot_size + sizeof (rational), r + sizeof (rational),
+                      slot_size - sizeof (rational)))
+         return s;
+   }
+}
+
+/****************************************************************************************/
+
+static void grow_table ()
+   /* doubles the number of slots of the hash table; the new table is built behind the  */
+   /* old one in the file and then moved to its beginning                               */
+
+{  long int    s, size = slots * slot_size;
+   char        *new_table;
+   T_CacheSlot head;
+
+   munmap (table, size);
+   resize_file (3 * size);
+   map_table (3 * size);
+   new_table = table + size;
+   for (s = 0; s < slots; s++)
+   {  memcpy (&head, table + s * slot_size, sizeof (T_CacheSlot));
+      if (head.d != 0)
+         memcpy (new_table + find_slot (new_table, 2 * slots, table + s * slot_size)
+                 * slot_size, table + s * slot_size, slot_size);
+   }
+   memmove (table, new_table, 2 * size);
+   munmap (table, 3 * size);
+   resize_file (2 * size);
+   slots *= 2;
+   map_table (2 * size);
+}
+
+/****************************************************************************************/
+
+static void spill (T_Tree *t, boolean all)
+   /* traverses the subtree t, keeping its nodes in node and moving the others to the   */
+   /* cache file; if all is FALSE, the nodes used since the previous traversal are kept */
+
+{  T_Tree      *right;
+   long int    s;
+   T_CacheSlot head;
+
+   if (t == NULL)
+      return;
+
+   spill (t -> tree_l, all);
+   right = t -> tree_r;
+   if (t -> vol < -0.5 || (t -> tree_u && !all))
+   {  t -> tree_u = FALSE;
+      node [kept++] = t;
+   }
+   else
+   {  if (cache_file != NULL)
+      {  build_record (t -> key, t -> vol);
+         s = find_slot (table, slots, record);
+         memcpy (&head, table + s * slot_size, sizeof (T_CacheSlot));
+         memcpy (table + s * slot_size, record, slot_size);
+         spilled++;
+         /* a volume retrieved from the file before is only overwritten */
+         if (head.d == 0 && 2 * (++used) > slots)
+            grow_table ();
+      }
+      memory -= node_size (t -> key);
+      nodes--;
+      free_set (t -> key.vertices.set);
+      my_free (t, sizeof (T_Tree));
+   }
+   spill (right, all);
+}
+
+/****************************************************************************************/
+
+static T_Tree *rebuild (long int low, long int high, int *height)
+   /* returns the perfectly balanced tree of node [low] to node [high] and its height */
+
+{  long int middle;
+   int      left, right;
+   T_Tree   *t;
+
+   if (low > high)
+   {  *height = 0;
+      return NULL;
+   }
+   middle = (low + high) / 2;
+   t = node [middle];
+   t -> tree_l = rebuild (low, middle - 1, &left);
+   t -> tree_r = rebuild (middle + 1, high, &right);
+   t -> tree_b = right - left;
+   *height = 1 + (left > right ? left : right);
+   return t;
+}
+
+/****************************************************************************************/
+
+static void shrink (T_Tree **tree, boolean all)
+   /* removes the nodes from the tree as described for "spill" */
+
+{  long int total = nodes;
+   int      height;
+
+   node = (T_Tree **) my_malloc (total * sizeof (T_Tree *));
+   kept = 0;
+   spill (*tree, all);
+   *tree = rebuild (0, kept - 1, &height);
+   my_free (node, total * sizeof (T_Tree *));
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
+
+void create_cache ()
+   /* prepares the accounting of the tree of face volumes and creates the cache file   */
+   /* if G_CacheFile is set; G_n must be set correctly.                                */
+
+{
+   budget = (G_CacheMemory < 0 ? DEFAULT_CACHE_MEMORY : G_CacheMemory) * 1048576L;
+   memory = 0;
+   nodes = 0;
+   spilled = 0;
+   retrieved = 0;
+
+   if (G_CacheFile != NULL)
+   {  if (! (cache_file = fopen (G_CacheFile, "w+b")))
+      {  fprintf (stderr, "\n***** ERROR: Could not open file '%s' in 'create_cache'.\n",
+                  G_CacheFile);
+         exit (0);
+      }
+      words = (G_n + 31) / 32;
+      slot_size = sizeof (T_CacheSlot) + words * sizeof (unsigned int);
+      slot_size = (slot_size + sizeof (rational) - 1) / sizeof (rational) * sizeof (rational);
+      record = (char *) my_malloc (slot_size);
+      slots = CACHE_SLOTS;
+      used = 0;
+      resize_file (slots * slot_size);
+      map_table (slots * slot_size);
+   }
+}
+
+/****************************************************************************************/
+
+void cache_added (T_Tree **tree, T_Key key, rational *volume)
+   /* to be called after the face with the given key has been inserted into the tree;  */
+   /* if the memory limit is exceeded, the tree is shrunk. If the volume of the face   */
+   /* is found in the cache file, it is stored in *volume, which must point to the     */
+   /* new node.                                                                        */
+
+{  long int    s;
+   T_CacheSlot head;
+
+   memory += node_size (key);
+   nodes++;
+   if (memory > budget)
+   {  shrink (tree, FALSE);
+      if (2 * memory > budget)
+         shrink (tree, TRUE);
+   }
+
+   if (cache_file != NULL)
+   {  build_record (key, 0);
+      s = find_slot (table, slots, record);
+      memcpy (&head, table + s * slot_size, sizeof (T_CacheSlot));
+      if (head.d != 0)
+      {  *volume = head.vol;
+         retrieved++;
+      }
+   }
+}
+
+/****************************************************************************************/
+
+void free_cache ()
+   /* closes and deletes the cache file and reports on its use */
+
+{
+   if (cache_file != NULL)
+   {  printf ("\n%li face volumes spilled to '%s', %li of them retrieved.",
+              spilled, G_CacheFile, retrieved);
+      munmap (table, slots * slot_size);
+      fclose (cache_file);
+      cache_file = NULL;
+      remove (G_CacheFile);
+      my_free (record, slot_size);
+   }
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
@@ -20,23 +20,26 @@
 /****************************************************************************************/
 
 #include "vinci.h"
+#include <pthread.h>
 
 /****************************************************************************************/
 
 rational factorial (int n)
    /* calculates n! by calculating all i! for 0 <= i <= G_d and storing them in an      */
-   /* array */
+   /* array, which is computed again when G_d changes                                   */
 
 {  static rational *fact;
-   static boolean  first_call = TRUE;
+   static int      dimension = -1;
    int i;
 
-   if (first_call)
+   if (dimension != G_d)
    {
+      if (dimension >= 0)
+         my_free (fact, (dimension + 1) * sizeof (rational));
       fact = create_fact ();
       fact [0] = 1;
       for (i = 1; i <= G_d; i++) fact [i] = i * fact [i - 1];
-      first_call = FALSE;
+      dimension = G_d;
    }
 
    return (fact [n]);
@@ -138,14 +141,16 @@ void simplex_volume (T_VertexSet S, rational *volume, boolean verbose)
    /* If verbose is TRUE an error message is output for zero volume.                    */
 
 {  static rational **A;
-   static boolean  first_call = TRUE;
+   static int      dimension = -1;
    rational dummy;
    int      i, j;
 
-   if (first_call)
+   if (dimension != G_d)
    {
+      if (dimension >= 0)
+         free_matrix (A, dimension, dimension);
       A = create_matrix (G_d, G_d);
-      first_call = FALSE;
+      dimension = G_d;
    }
 
    /* copy the relevant information into A */
@@ -179,32 +184,29 @@ rational add_orthonormal (int d, T_VertexSet face, rational **H, T_Vertex *verte
    /* later steps!                                                                      */
    /* Return value is the distance of the vertex to face.                               */
 
-{  int      i, j;
-   rational scalar_product, alpha_squared, alpha, divisor, distance, mindistance = 1e99;
+{  int      i, j, nearest = 0;
+   rational alpha_squared, alpha, divisor, distance, mindistance = 1e99,
+            difference, *x = vertex -> coords, *y, *h = H [d-1];
 
    /* look for the vertex in face with the smallest distance to the given vertex  */
    for (i = 0; i <= face.lastel; i++)
-   {
+   {  y = face.loe [i] -> coords;
       distance = 0;
       for (j = 0; j < G_d; j++)
-         distance +=   (vertex -> coords [j] - face.loe [i] -> coords [j])
-                     * (vertex -> coords [j] - face.loe [i] -> coords [j]);
+      {  difference = x [j] - y [j];
+         distance += difference * difference;
+      }
       if (distance < mindistance)
       {  mindistance = distance;
-         for (j = 0; j < G_d; j++)
-            H [d-1] [j] = vertex -> coords [j] - face.loe [i] -> coords [j];
+         nearest = i;
       }
    }
+   y = face.loe [nearest] -> coords;
+   for (j = 0; j < G_d; j++)
+      h [j] = x [j] - y [j];
 
    /* multiply from the left with the previous Householder matrices */
-   for (i = 0; i < d-1; i++)
-   {  scalar_product = 0;
-      for (j = i; j < G_d; j++)
-         scalar_product += H [i] [j] * H [d-1] [j];
-      scalar_product *= 2;
-      for (j = i; j < G_d; j++)
-         H [d-1] [j] -= scalar_product * H [i] [j];
-   }
+   apply_householder (d-1, H, h);
 
    /* compute the new Householder vector and the distance */
    alpha_squared = 0;
@@ -225,6 +227,44 @@ rational add_orthonormal (int d, T_VertexSet face, rational **H, T_Vertex *verte
 
 /****************************************************************************************/
 
+void apply_householder (int d, rational **H, rational *x)
+   /* The function assumes in the first d rows of H the Householder vectors of a face,  */
+   /* as computed by "orthonormal" or "add_orthonormal", and multiplies the vector x    */
+   /* with G_d entries from the left with the corresponding Householder matrices. If x  */
+   /* is parallel to the face, its first d entries are then its coordinates in an       */
+   /* orthonormal basis of the face, and the remaining entries vanish.                  */
+
+{  int      j, k;
+   rational scalar_product, *h;
+
+   for (k = 0; k < d; k++)
+   {  h = H [k];
+      scalar_product = 0;
+      for (j = k; j < G_d; j++)
+         scalar_product += h [j] * x [j];
+      scalar_product *= 2;
+      for (j = k; j < G_d; j++)
+         x [j] -= scalar_product * h [j];
+   }
+}
+
+/****************************************************************************************/
+
+void local_coordinates (int d, rational **H, T_Vertex *origin, T_Vertex *vertex,
+   rational *x)
+   /* H is as in "apply_householder" for a face containing origin. The coordinates of  */
+   /* vertex in the affine hull of the face, with origin as zero, are stored in the     */
+   /* first d entries of x, which must have G_d entries.                                */
+
+{  int j;
+
+   for (j = 0; j < G_d; j++)
+      x [j] = vertex -> coords [j] - origin -> coords [j];
+   apply_householder (d, H, x);
+}
+
+/****************************************************************************************/
+
 rational orthonormal (int d, T_VertexSet face, rational **H)
    /* The function computes Householder vectors for the linear subspace associated with */
    /* the variable face. The vectors are returned via the first d rows of H.            */
@@ -232,16 +272,21 @@ rational orthonormal (int d, T_VertexSet face, rational **H)
    /* The return value is d! times the volume of the orthonormalised simplex.           */
 
 {  static rational **local_H;
-   static int      m = 0;
-      /* the number of rows in local_H */
+   static int      m = 0, dimension;
+      /* the number of rows in local_H and the value of G_d for which it was created */
    rational *dummy_row;
    int      i, j, k, maxindex = 0;
-   rational scalar_product, alpha_squared = -1, alpha, divisor;
-   rational volume = 1;
+   rational scalar_product, product_2, alpha_squared = -1, alpha, divisor;
+   rational volume = 1, *h, *x, *y;
 
    /* create local_H in the correct dimension */
+   if (m != 0 && dimension != G_d)
+   {  free_matrix (local_H, m, dimension + 1);
+      m = 0;
+   }
    if (m == 0)
    {
+      dimension = G_d;
       m = face.lastel;
       local_H = create_matrix (m, G_d + 1);
          /* The last component of each row will contain the norm of the essential part  */
@@ -293,22 +338,46 @@ rational orthonormal (int d, T_VertexSet face, rational **H)
          local_H [k] [j] /= divisor;
 
       /* apply the Householder matrix to the resting rows of local_H; at the same time  */
-      /* compute the norms of the relevant parts                                        */
+      /* compute the norms of the relevant parts. The rows are treated in pairs, so     */
+      /* that the Householder vector is loaded only once for two of them.               */
       alpha_squared = -1;
-      for (i = k + 1; i < face.lastel; i++)
-      {
-         scalar_product = 0;
-         for (j = k; j < G_d; j++)
-            scalar_product += local_H [k] [j] * local_H [i] [j];
-         scalar_product *= 2;
-         for (j = k; j < G_d; j++)
-            local_H [i] [j] -= scalar_product * local_H [k] [j];
-
-         local_H [i] [G_d] -= local_H [i] [k] * local_H [i] [k];
-         if (local_H [i] [G_d] > alpha_squared)
-         {  alpha_squared = local_H [i] [G_d];
+      h = local_H [k];
+      for (i = k + 1; i < face.lastel; i += 2)
+      {  x = local_H [i];
+         if (i + 1 < face.lastel)
+         {  y = local_H [i+1];
+            scalar_product = 0;
+            product_2 = 0;
+            for (j = k; j < G_d; j++)
+            {  scalar_product += h [j] * x [j];
+               product_2 += h [j] * y [j];
+            }
+            scalar_product *= 2;
+            product_2 *= 2;
+            for (j = k; j < G_d; j++)
+            {  x [j] -= scalar_product * h [j];
+               y [j] -= product_2 * h [j];
+            }
+            y [G_d] -= y [k] * y [k];
+         }
+         else
+         {  scalar_product = 0;
+            for (j = k; j < G_d; j++)
+               scalar_product += h [j] * x [j];
+            scalar_product *= 2;
+            for (j = k; j < G_d; j++)
+               x [j] -= scalar_product * h [j];
+         }
+
+         x [G_d] -= x [k] * x [k];
+         if (x [G_d] > alpha_squared)
+         {  alpha_squared = x [G_d];
             maxindex = i;
          }
+         if (i + 1 < face.lastel && local_H [i+1] [G_d] > alpha_squared)
+         {  alpha_squared = local_H [i+1] [G_d];
+            maxindex = i + 1;
+         }
       }
 
    } /* for */
@@ -322,3 +391,200 @@ rational orthonormal (int d, T_VertexSet face, rational **H)
 }
 
 /****************************************************************************************/
+/*                      integration of polynomials over simplices                       */
+/****************************************************************************************/
+
+/* The integrals of all monomials up to a given degree p are accumulated over the       */
+/* simplices of a triangulation. On each simplex the cubature formula of Grundmann and  */
+/* Moeller of degree 2s+1 >= p is applied, which is exact for polynomials of this       */
+/* degree. Its nodes have the barycentric coordinates (2 b_0 + 1, ..., 2 b_d + 1) /     */
+/* (2s + 1 + d - 2i) for i = 0, ..., s and b_0 + ... + b_d = s - i; the weights of the  */
+/* standard simplex are (-1)^i 2^-2s (2s + 1 + d - 2i)^(2s+1) / (i! (2s + 1 + d - i)!). */
+
+static int      moment_degree, monomials, nodes;
+   /* degree p, number of monomials and number of nodes of the cubature formula */
+static int      **exponent;
+   /* the exponents of the monomials, ordered by degree and lexicographically inverse */
+static rational **barycentric, *weight;
+   /* the nodes and weights of the cubature formula */
+static rational **power, *point;
+   /* work space: the powers of the coordinates of a point up to p, and the point */
+
+/****************************************************************************************/
+
+static rational fact (int n)
+   /* n! without restriction to n <= G_d */
+
+{  rational f = 1;
+
+   for (; n > 1; n--)
+      f *= n;
+   return f;
+}
+
+/****************************************************************************************/
+
+static void compositions (int *b, int j, int rest, int denominator, rational w)
+   /* adds the nodes whose barycentric coordinates 0, ..., j-1 are fixed by b; rest is  */
+   /* the sum left for the remaining ones. For nodes = -1, they are only counted.       */
+
+{  int i;
+
+   if (j == G_d)
+   {  b [G_d] = rest;
+      if (barycentric != NULL)
+      {  for (i = 0; i <= G_d; i++)
+            barycentric [nodes] [i] = (rational) (2 * b [i] + 1) / denominator;
+         weight [nodes] = w;
+      }
+      nodes++;
+   }
+   else
+      for (b [j] = 0; b [j] <= rest; b [j]++)
+         compositions (b, j + 1, rest - b [j], denominator, w);
+}
+
+/****************************************************************************************/
+
+static void monomials_of_degree (int *e, int j, int rest)
+   /* adds the monomials whose exponents 0, ..., j-1 are fixed by e; rest is the        */
+   /* degree left for the remaining ones. For exponent = NULL, they are only counted.   */
+
+{
+   if (j == G_d - 1)
+   {  e [j] = rest;
+      if (exponent != NULL)
+         memcpy (exponent [monomials], e, G_d * sizeof (int));
+      monomials++;
+   }
+   else
+      for (e [j] = rest; e [j] >= 0; e [j]--)
+         monomials_of_degree (e, j + 1, rest - e [j]);
+}
+
+/****************************************************************************************/
+
+static void enumerate_moments ()
+   /* enumerates the monomials and the nodes; if the arrays are NULL, they are only     */
+   /* counted */
+
+{  int      i, k, s = moment_degree / 2, q = 2 * s + 1, *b = create_int_vector (G_d + 1);
+   rational w;
+
+   monomials = 0;
+   for (k = 0; k <= moment_degree; k++)
+      monomials_of_degree (b, 0, k);
+
+   nodes = 0;
+   for (i = 0; i <= s; i++)
+   {  w = pow (q + G_d - 2 * i, q) / pow (2, 2 * s) / (fact (i) * fact (q + G_d - i));
+      if (i % 2 == 1)
+         w = -w;
+      compositions (b, 0, s - i, q + G_d - 2 * i, w);
+   }
+
+   free_int_vector (b, G_d + 1);
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
+
+int init_moments (int p)
+   /* prepares the integration of the monomials up to degree p and returns their number */
+
+{  int i;
+
+   moment_degree = p;
+   exponent = NULL;
+   barycentric = NULL;
+   enumerate_moments ();
+
+   exponent = (int **) my_malloc (monomials * sizeof (int *));
+   for (i = 0; i < monomials; i++)
+      exponent [i] = create_int_vector (G_d);
+   barycentric = create_matrix (nodes, G_d + 1);
+   weight = (rational *) my_malloc (nodes * sizeof (rational));
+   enumerate_moments ();
+
+   power = create_matrix (G_d, p + 1);
+   point = create_vector ();
+
+   return monomials;
+}
+
+/****************************************************************************************/
+
+void free_moments ()
+
+{  int i;
+
+   for (i = 0; i < monomials; i++)
+      free_int_vector (exponent [i], G_d);
+   my_free (exponent, monomials * sizeof (int *));
+   free_matrix (barycentric, nodes, G_d + 1);
+   my_free (weight, nodes * sizeof (rational));
+   free_matrix (power, G_d, moment_degree + 1);
+   free_vector (point);
+}
+
+/****************************************************************************************/
+
+int * monomial_exponents (int k)
+   /* returns the exponents of monomial k */
+
+{
+   return exponent [k];
+}
+
+/****************************************************************************************/
+
+void simplex_moments (T_VertexSet S, rational volume, rational *moments)
+   /* adds the integrals of the monomials over the simplex S with G_d! times the volume */
+   /* "volume", as computed by "simplex_volume", to the array moments */
+
+{  int      i, j, k, l;
+   rational value;
+
+   for (l = 0; l < nodes; l++)
+   {  for (j = 0; j < G_d; j++)
+      {  point [j] = 0;
+         for (i = 0; i <= G_d; i++)
+            point [j] += barycentric [l] [i] * S.loe [i] -> coords [j];
+         power [j] [0] = 1;
+         for (k = 1; k <= moment_degree; k++)
+            power [j] [k] = power [j] [k-1] * point [j];
+      }
+      for (k = 0; k < monomials; k++)
+      {  value = weight [l] * volume;
+         for (j = 0; j < G_d; j++)
+            value *= power [j] [exponent [k] [j]];
+         moments [k] += value;
+      }
+   }
+}
+
+/****************************************************************************************/
+
+void run_jobs (void *(*f) (void *), void *job, size_t size, int threads)
+   /* applies f to each of the threads jobs of size bytes stored one after the other   */
+   /* from job on, using a thread for each of them if there are several                */
+
+{  int       t;
+   pthread_t *thread;
+
+   if (threads == 1)
+      f (job);
+   else
+   {  thread = (pthread_t *) my_malloc (threads * sizeof (pthread_t));
+      for (t = 0; t < threads; t++)
+         if (pthread_create (&(thread [t]), NULL, f, (char *) job + t * size) != 0)
+         {  fprintf (stderr, "\n***** ERROR: Could not create a thread in 'run_jobs'.\n");
+            exit (0);
+         }
+      for (t = 0; t < threads; t++)
+         pthread_join (thread [t], NULL);
+      my_free (thread, threads * sizeof (pthread_t));
+   }
+}
+
+/****************************************************************************************/
@@ -0,0 +1,305 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                     vinci_dd.c                                       */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* Authors: Benno Bueeler (bueeler@ifor.math.ethz.ch)                                   */
+/*          and                                                                         */
+/*          Andreas Enge (enge@ifor.math.ethz.ch)                                       */
+/*          Institute for Operations Research                                           */
+/*	    Swiss Federal Institute of Technology Zurich                                */
+/*	    Switzerland                                                                 */
+/*                                                                                      */
+/* Last Changes: October 19, 2026                                                       */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* vertex enumeration by the double description method                                  */
+/*                                                                                      */
+/****************************************************************************************/
+
+#include "vinci.h"
+
+/* The polytope {x : a_i x <= b_i} is homogenised to the cone {(x, t) : a_i x - b_i t   */
+/* <= 0, -t <= 0}, whose extreme rays with t > 0 are the vertices scaled by t. The      */
+/* rays are computed by adding the constraints one by one to the cone spanned by an     */
+/* initial simplicial cone; rays violating the new constraint are replaced by the       */
+/* combinations of adjacent pairs of a satisfying and a violating ray. Two rays are     */
+/* adjacent if no third ray is tight at all constraints at which both are tight.        */
+
+static int     rows, dim;
+   /* number of constraints of the cone (including t >= 0) and dimension of the space */
+static real    **H;
+   /* the constraints, normalised to length 1 */
+static int     rays, maxrays;
+   /* number of rays and size of the arrays */
+static real    **ray;
+   /* the rays, normalised to length 1 */
+static boolean **zero;
+   /* zero [r] [i] tells whether ray r is tight at constraint i; the entries for        */
+   /* constraints not yet added are FALSE */
+
+/****************************************************************************************/
+
+static void normalise (real *x)
+
+{  int  j;
+   real norm = 0;
+
+   for (j = 0; j < dim; j++)
+      norm += x [j] * x [j];
+   norm = sqrt (norm);
+   if (norm > 0)
+      for (j = 0; j < dim; j++)
+         x [j] /= norm;
+}
+
+/****************************************************************************************/
+
+static real evaluate (int i, int r)
+   /* returns the value of constraint i at ray r */
+
+{  int  j;
+   real value = 0;
+
+   for (j = 0; j < dim; j++)
+      value += H [i] [j] * ray [r] [j];
+   return value;
+}
+
+/****************************************************************************************/
+
+static int new_ray ()
+   /* reserves space for one more ray and returns its index */
+
+{  int r;
+
+   if (rays == maxrays)
+   {  ray = (real **) my_realloc (ray, 2 * maxrays * sizeof (real *),
+                                  maxrays * sizeof (real *));
+      zero = (boolean **) my_realloc (zero, 2 * maxrays * sizeof (boolean *),
+                                      maxrays * sizeof (boolean *));
+      for (r = maxrays; r < 2 * maxrays; r++)
+      {  ray [r] = (real *) my_malloc (dim * sizeof (real));
+         zero [r] = (boolean *) my_malloc (rows * sizeof (boolean));
+      }
+      maxrays *= 2;
+   }
+   return rays++;
+}
+
+/****************************************************************************************/
+
+static boolean adjacent (int p, int n, int limit, boolean *common)
+   /* tests whether the rays p and n are adjacent among the rays 0 to limit-1; common   */
+   /* is filled with the constraints at which both are tight */
+
+{  int i, r, count = 0;
+
+   for (i = 0; i < rows; i++)
+   {  common [i] = zero [p] [i] && zero [n] [i];
+      if (common [i])
+         count++;
+   }
+   if (count < dim - 2)
+      return FALSE;
+
+   for (r = 0; r < limit; r++)
+      if (r != p && r != n)
+      {  i = 0;
+         while (i < rows && (!common [i] || zero [r] [i]))
+            i++;
+         if (i == rows)
+            return FALSE;
+      }
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+static boolean initial_cone (boolean *chosen)
+   /* chooses dim linearly independent constraints, starting with t >= 0, and computes  */
+   /* the rays of the simplicial cone they define; chosen [i] is set for these          */
+   /* constraints. If the constraints have a smaller rank, FALSE is returned.           */
+
+{  int      i, j, k, l, found = 0, *basis;
+   real     **Q, **A, product, norm;
+   boolean  ok = TRUE;
+
+   basis = create_int_vector (dim);
+   Q = create_matrix (dim, dim);
+   for (l = 0; l < rows && found < dim; l++)
+   {  /* orthogonalise constraint i against those chosen so far */
+      i = (l == 0 ? rows - 1 : l - 1);
+      for (j = 0; j < dim; j++)
+         Q [found] [j] = H [i] [j];
+      for (k = 0; k < found; k++)
+      {  product = 0;
+         for (j = 0; j < dim; j++)
+            product += Q [found] [j] * Q [k] [j];
+         for (j = 0; j < dim; j++)
+            Q [found] [j] -= product * Q [k] [j];
+      }
+      norm = 0;
+      for (j = 0; j < dim; j++)
+         norm += Q [found] [j] * Q [found] [j];
+      if (norm > DD_EPSILON)
+      {  normalise (Q [found]);
+         basis [found++] = i;
+         chosen [i] = TRUE;
+      }
+   }
+   free_matrix (Q, dim, dim);
+
+   if (found < dim)
+      ok = FALSE;
+   else
+   {  /* the rays are the columns of -B^-1 for the matrix B of the chosen constraints */
+      A = create_matrix (dim, 2 * dim);
+      for (k = 0; k < dim; k++)
+         for (j = 0; j < dim; j++)
+         {  A [k] [j] = H [basis [k]] [j];
+            A [k] [dim + j] = (j == k ? -1 : 0);
+         }
+      det_and_invert (A, dim, 2 * dim, FALSE);
+      for (k = 0; k < dim; k++)
+      {  new_ray ();
+         for (j = 0; j < dim; j++)
+            ray [k] [j] = A [j] [dim + k];
+         normalise (ray [k]);
+         for (i = 0; i < rows; i++)
+            zero [k] [i] = FALSE;
+         for (i = 0; i < dim; i++)
+            zero [k] [basis [i]] = (i != k);
+      }
+      free_matrix (A, dim, 2 * dim);
+   }
+
+   free_int_vector (basis, dim);
+   return ok;
+}
+
+/****************************************************************************************/
+
+static void add_constraint (int h)
+   /* intersects the cone with constraint h */
+
+{  int     p, n, r, i, j, old_rays = rays;
+   real    *value = (real *) my_malloc (rays * sizeof (real));
+   boolean *common = (boolean *) my_malloc (rows * sizeof (boolean));
+
+   for (r = 0; r < old_rays; r++)
+   {  value [r] = evaluate (h, r);
+      if (fabs (value [r]) < DD_EPSILON)
+      {  value [r] = 0;
+         zero [r] [h] = TRUE;
+      }
+   }
+
+   /* create the combinations of adjacent pairs; they are tight at h */
+   for (p = 0; p < old_rays; p++)
+      if (value [p] > 0)
+         for (n = 0; n < old_rays; n++)
+            if (value [n] < 0)
+            {  /* the new rays need not be taken into account by the test */
+               if (adjacent (p, n, old_rays, common))
+               {  r = new_ray ();
+                  for (j = 0; j < dim; j++)
+                     ray [r] [j] = value [p] * ray [n] [j] - value [n] * ray [p] [j];
+                  normalise (ray [r]);
+                  for (i = 0; i < rows; i++)
+                     zero [r] [i] = common [i];
+                  zero [r] [h] = TRUE;
+               }
+            }
+
+   /* remove the rays violating h by moving the last ones into their places */
+   for (r = old_rays - 1; r >= 0; r--)
+      if (value [r] > 0)
+      {  rays--;
+         if (r != rays)
+         {  memcpy (ray [r], ray [rays], dim * sizeof (real));
+            memcpy (zero [r], zero [rays], rows * sizeof (boolean));
+         }
+      }
+
+   my_free (value, old_rays * sizeof (real));
+   my_free (common, rows * sizeof (boolean));
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
+
+int dd_vertices (real **planes, int m, rational ***vertices)
+   /* enumerates the vertices of the polytope {x : planes [i] x <= planes [i] [G_d],    */
+   /* i = 0, ..., m-1} in the format of G_Hyperplanes. The coordinates of the vertices  */
+   /* are returned in the newly created matrix *vertices, which has one row for each of */
+   /* them, and their number is returned. If the polyhedron is empty or unbounded, -1   */
+   /* is returned and *vertices is not set.                                             */
+
+{  int     i, j, r, n;
+   boolean ok, *chosen;
+
+   dim = G_d + 1;
+   rows = m + 1;
+   H = create_matrix (rows, dim);
+   for (i = 0; i < m; i++)
+   {  for (j = 0; j < G_d; j++)
+         H [i] [j] = planes [i] [j];
+      H [i] [G_d] = - planes [i] [G_d];
+      normalise (H [i]);
+   }
+   for (j = 0; j < G_d; j++)
+      H [m] [j] = 0;
+   H [m] [G_d] = -1;
+
+   maxrays = 2 * dim;
+   rays = 0;
+   ray = (real **) my_malloc (maxrays * sizeof (real *));
+   zero = (boolean **) my_malloc (maxrays * sizeof (boolean *));
+   for (r = 0; r < maxrays; r++)
+   {  ray [r] = (real *) my_malloc (dim * sizeof (real));
+      zero [r] = (boolean *) my_malloc (rows * sizeof (boolean));
+   }
+
+   chosen = (boolean *) my_malloc (rows * sizeof (boolean));
+   for (i = 0; i < rows; i++)
+      chosen [i] = FALSE;
+
+   ok = initial_cone (chosen);
+   for (i = 0; i < rows && ok; i++)
+      if (!chosen [i])
+         add_constraint (i);
+
+   /* all rays must be vertices */
+   for (r = 0; r < rays && ok; r++)
+      if (ray [r] [G_d] < DD_EPSILON)
+         ok = FALSE;
+   if (rays == 0)
+      ok = FALSE;
+
+   if (ok)
+   {  n = rays;
+      *vertices = create_matrix (n, G_d);
+      for (r = 0; r < n; r++)
+         for (j = 0; j < G_d; j++)
+            (*vertices) [r] [j] = ray [r] [j] / ray [r] [G_d];
+   }
+   else
+      n = -1;
+
+   my_free (chosen, rows * sizeof (boolean));
+   for (r = 0; r < maxrays; r++)
+   {  my_free (ray [r], dim * sizeof (real));
+      my_free (zero [r], rows * sizeof (boolean));
+   }
+   my_free (ray, maxrays * sizeof (real *));
+   my_free (zero, maxrays * sizeof (boolean *));
+   free_matrix (H, rows, dim);
+
+   return n;
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
@@ -19,7 +19,100 @@
 /*                                                                                      */
 /****************************************************************************************/
 
+#define _POSIX_C_SOURCE 200112L
+   /* for running lrs in a child process and mapping the input files into memory */
+
 #include "vinci.h"
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static pid_t lrs_pid, feeder_pid, gzip_pid = 0;
+   /* the processes running lrs, writing its input and decompressing an input file */
+
+static boolean    buffer_input = FALSE;
+static const char *vertex_block = NULL, *vertex_end, *planes_block = NULL, *planes_end;
+static char       *buffer_name;
+   /* the polytope set up by 'read_polytope_buffer' */
+
+/****************************************************************************************/
+
+typedef struct
+{  FILE     *f;
+   char     *buffer;
+   long int start, stop;
+      /* the unread data in the buffer */
+   boolean  end;
+      /* whether the end of the file has been reached */
+} T_Stream;
+   /* a file read through a buffer of STREAM_BUFFER bytes */
+
+/****************************************************************************************/
+
+static boolean is_gzip (const char *s, size_t size)
+   /* checks whether the data start with the magic bytes of gzip */
+
+{
+   return (size >= 2 && (unsigned char) s [0] == 0x1f && (unsigned char) s [1] == 0x8b);
+}
+
+/****************************************************************************************/
+
+static FILE *open_input (char *filename)
+   /* opens the specified file for reading; if it is compressed by gzip, GZIP_EXEC is   */
+   /* started in a child process, and its decompressed output is returned as a stream, */
+   /* so that the file is decompressed while it is read. Returns NULL if the file      */
+   /* cannot be opened.                                                                */
+
+{  FILE *f;
+   char magic [2];
+   int  output [2];
+
+   if (! (f = fopen (filename, "r")))
+      return NULL;
+   if (fread (magic, 1, 2, f) != 2 || !is_gzip (magic, 2))
+   {  rewind (f);
+      return f;
+   }
+   fclose (f);
+
+   fflush (stdout);
+   if (pipe (output) != 0)
+   {  fprintf (stderr, "\n***** ERROR: Could not create a pipe in 'open_input'.\n");
+      exit (0);
+   }
+   gzip_pid = fork ();
+   if (gzip_pid == 0)
+   {  dup2 (output [1], 1);
+      close (output [0]);
+      close (output [1]);
+      execlp (GZIP_EXEC, GZIP_EXEC, "-dc", filename, (char *) NULL);
+      fprintf (stderr, "\n***** ERROR: Could not execute '%s' in 'open_input'.\n", GZIP_EXEC);
+      _exit (1);
+   }
+   close (output [1]);
+   if (gzip_pid < 0 || ! (f = fdopen (output [0], "r")))
+   {  fprintf (stderr, "\n***** ERROR: Could not start '%s' in 'open_input'.\n", GZIP_EXEC);
+      exit (0);
+   }
+   return f;
+}
+
+/****************************************************************************************/
+
+static void close_input (FILE *f)
+   /* closes a file opened by "open_input" and waits for the decompressing process */
+
+{
+   fclose (f);
+   if (gzip_pid > 0)
+   {  waitpid (gzip_pid, NULL, 0);
+      gzip_pid = 0;
+   }
+}
 
 /****************************************************************************************/
 
@@ -32,7 +125,7 @@ FILE * open_read (char filename [255])
    boolean begin_found = FALSE;
    
 
-   if (! (fp = fopen (filename, "r")))
+   if (! (fp = open_input (filename)))
    {  fprintf (stderr, "\n***** ERROR: Could not open file '%s' in 'open_read'.\n", filename);
       exit (0);
    };
@@ -69,64 +162,676 @@ int determine_data_type (char *data_type)
 
 /****************************************************************************************/
 
+static const real powers_of_ten [] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+   1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+   /* the powers of ten which are exactly representable as doubles */
+
+#define IS_SPACE(c) ((c) == ' ' || (c) == '\n' || (c) == '\t' || (c) == '\r' \
+                     || (c) == '\f' || (c) == '\v')
+
+/****************************************************************************************/
+
+static const char *scan_decimal (const char *s, const char *end, real *value)
+   /* reads a number with optional sign, decimal point and exponent from the string    */
+   /* starting at s and ending before end and returns a pointer behind it, or NULL if  */
+   /* there is no digit. With at most 15 significant digits and an exponent of at most */
+   /* 22 the mantissa and the power of ten are exact, so that a single multiplication  */
+   /* or division gives the correctly rounded value; otherwise strtod is called.       */
+
+{  const char *start = s;
+   char       token [255];
+   real       mantissa = 0;
+   int        digits = 0, significant = 0, exponent = 0, e = 0, e_sign = 1;
+   boolean    negative = FALSE;
+
+   if (s < end && (*s == '-' || *s == '+'))
+      negative = (*(s++) == '-');
+   for (; s < end && *s >= '0' && *s <= '9'; s++, digits++)
+      if (mantissa != 0 || *s != '0')
+      {  mantissa = 10 * mantissa + (*s - '0');
+         significant++;
+      }
+   if (s < end && *s == '.')
+      for (s++; s < end && *s >= '0' && *s <= '9'; s++, digits++, exponent--)
+         if (mantissa != 0 || *s != '0')
+         {  mantissa = 10 * mantissa + (*s - '0');
+            significant++;
+         }
+   if (digits == 0)
+      return NULL;
+   if (s < end && (*s == 'e' || *s == 'E'))
+   {  s++;
+      if (s < end && (*s == '-' || *s == '+'))
+         e_sign = (*(s++) == '-' ? -1 : 1);
+      if (s == end || *s < '0' || *s > '9')
+         return NULL;
+      for (; s < end && *s >= '0' && *s <= '9'; s++)
+         if (e < 10000)
+            e = 10 * e + (*s - '0');
+      exponent += e_sign * e;
+   }
+
+   if (significant <= 15 && exponent >= -22 && exponent <= 22)
+   {  if (exponent >= 0)
+         *value = mantissa * powers_of_ten [exponent];
+      else
+         *value = mantissa / powers_of_ten [- exponent];
+      if (negative)
+         *value = - *value;
+   }
+   else
+   {  if (s - start >= 255)
+         return NULL;
+      memcpy (token, start, s - start);
+      token [s - start] = '\0';
+      *value = strtod (token, NULL);
+   }
+   return s;
+}
+
+/****************************************************************************************/
+
+static const char *scan_number (const char *s, const char *end, real *value)
+   /* reads a number as described for "scan_decimal" or a fraction of two such numbers */
+   /* from the token starting at s and returns a pointer behind the token, or NULL if  */
+   /* it is not a number                                                               */
+
+{  real denominator;
+
+   if ((s = scan_decimal (s, end, value)) == NULL)
+      return NULL;
+   if (s < end && *s == '/')
+   {  if ((s = scan_decimal (s + 1, end, &denominator)) == NULL)
+         return NULL;
+      *value /= denominator;
+   }
+   if (s < end && !IS_SPACE (*s))
+      return NULL;
+   return s;
+}
+
+/****************************************************************************************/
+
 void sread_rational_value (char *s, rational *value)
    /* reads a rational value from the specified string "s" and assigns it to "value"    */
 
+{  const char *end = s + strlen (s);
+   real       x;
+
+   while (s < end && IS_SPACE (*s))
+      s++;
+   if (scan_number (s, end, &x) != NULL)
+      *value = x;
+   else
+      *value = 0;
+}
+
+/****************************************************************************************/
+
+static char *map_file (char *filename, size_t *size)
+   /* maps the file read-only into memory and returns its address and size, or NULL if */
+   /* it cannot be opened or is empty                                                  */
+
+{  int         fd;
+   struct stat status;
+   char        *s;
+
+   if ((fd = open (filename, O_RDONLY)) < 0)
+      return NULL;
+   if (fstat (fd, &status) != 0 || status.st_size == 0)
+   {  close (fd);
+      return NULL;
+   }
+   *size = status.st_size;
+   s = (char *) mmap (NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close (fd);
+   if (s == MAP_FAILED)
+      return NULL;
+   posix_madvise (s, *size, POSIX_MADV_SEQUENTIAL);
+   return s;
+}
+
+/****************************************************************************************/
+
+static const char *scan_header (const char *s, const char *end, int *rows, int *columns,
+   int *data_type)
+   /* skips the lines up to a line 'begin' and reads the number of rows, the number of */
+   /* columns and the data type following it; returns a pointer behind the header, or  */
+   /* NULL if there is no line 'begin' or the header is incomplete                     */
+
+{  char token [255];
+   int  i, entry;
+   real x;
+
+   while (s < end && (end - s < 5 || strncmp (s, "begin", 5)))
+   {  while (s < end && *s != '\n')
+         s++;
+      if (s < end)
+         s++;
+   }
+   if (s == end)
+      return NULL;
+   while (s < end && *s != '\n')
+      s++;
+
+   for (entry = 0; entry < 3; entry++)
+   {  while (s < end && IS_SPACE (*s))
+         s++;
+      if (s == end)
+         return NULL;
+      if (entry < 2)
+      {  if ((s = scan_number (s, end, &x)) == NULL)
+            return NULL;
+         *(entry == 0 ? rows : columns) = (int) x;
+      }
+      else
+      {  for (i = 0; s < end && !IS_SPACE (*s) && i < 254; s++, i++)
+            token [i] = *s;
+         token [i] = '\0';
+         *data_type = determine_data_type (token);
+      }
+   }
+   return s;
+}
+
+/****************************************************************************************/
+
+static boolean refill (T_Stream *s)
+   /* moves the unread data to the beginning of the buffer and appends as much as     */
+   /* possible from the file; returns FALSE if nothing could be added                 */
+
+{  size_t got;
+
+   memmove (s -> buffer, s -> buffer + s -> start, s -> stop - s -> start);
+   s -> stop -= s -> start;
+   s -> start = 0;
+   if (s -> end || s -> stop == STREAM_BUFFER)
+      return FALSE;
+   got = fread (s -> buffer + s -> stop, 1, STREAM_BUFFER - s -> stop, s -> f);
+   if (got == 0)
+   {  s -> end = TRUE;
+      return FALSE;
+   }
+   s -> stop += got;
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+static const char *stream_line (T_Stream *s, long int *length)
+   /* returns the next line of the stream without the newline and sets its length, or  */
+   /* NULL at the end of the stream; lines longer than the buffer are split            */
+
+{  long int   i;
+   const char *line;
+
+   for (;;)
+   {  i = s -> start;
+      while (i < s -> stop && s -> buffer [i] != '\n')
+         i++;
+      if (i < s -> stop)
+         break;
+      if (!refill (s))
+      {  if (s -> start == s -> stop)
+            return NULL;
+         i = s -> stop;
+         break;
+      }
+   }
+   line = s -> buffer + s -> start;
+   *length = i - s -> start;
+   s -> start = (i < s -> stop ? i + 1 : i);
+   return line;
+}
+
+/****************************************************************************************/
+
+static const char *stream_token (T_Stream *s, long int *length)
+   /* returns the next token of the stream and sets its length, or NULL at the end of  */
+   /* the stream; tokens longer than the buffer are split                              */
+
+{  long int   i;
+   const char *token;
+
+   for (;;)
+   {  while (s -> start < s -> stop && IS_SPACE (s -> buffer [s -> start]))
+         s -> start++;
+      i = s -> start;
+      while (i < s -> stop && !IS_SPACE (s -> buffer [i]))
+         i++;
+      if (i < s -> stop)
+         break;
+      if (!refill (s))
+      {  if (s -> start == s -> stop)
+            return NULL;
+         i = s -> stop;
+         break;
+      }
+   }
+   token = s -> buffer + s -> start;
+   *length = i - s -> start;
+   s -> start = i;
+   return token;
+}
+
+/****************************************************************************************/
+
+static boolean stream_header (T_Stream *s, int *rows, int *columns, int *data_type)
+   /* reads the lines of the stream up to a line 'begin' and the header following it  */
+   /* as described for "scan_header"; returns FALSE if they are not found             */
+
+{  const char *line, *token;
+   long int   length;
+   char       type [255];
+   real       x;
+
+   do
+      line = stream_line (s, &length);
+   while (line != NULL && (length < 5 || strncmp (line, "begin", 5)));
+   if (line == NULL)
+      return FALSE;
+
+   if ((token = stream_token (s, &length)) == NULL
+       || scan_number (token, token + length, &x) != token + length)
+      return FALSE;
+   *rows = (int) x;
+   if ((token = stream_token (s, &length)) == NULL
+       || scan_number (token, token + length, &x) != token + length)
+      return FALSE;
+   *columns = (int) x;
+   if ((token = stream_token (s, &length)) == NULL)
+      return FALSE;
+   if (length > 254)
+      length = 254;
+   memcpy (type, token, length);
+   type [length] = '\0';
+   *data_type = determine_data_type (type);
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+static void open_stream (T_Stream *s, FILE *f)
+   /* prepares the stream for reading from f */
+
 {
-   char     *numerator_s, *denominator_s = NULL, *position, token;
-   int      sign = 1, i;
-   rational numerator, denominator;
-
-   /* determine the sign of the number */
-   numerator_s = s;
-   if (s [0] == '-')
-   {  sign = -1;
-      numerator_s++;
-   }
-   else if (s [0] == '+')
-      numerator_s++;
-
-   /* look for a sign '/' and in this case split the number in numerator and denominator */
-   position = strchr (numerator_s, '/');
-   if (position != NULL)
-   {  *position = '\0'; /* terminates the numerator */
-      denominator_s = position + 1;
-   };
+   s -> f = f;
+   s -> buffer = (char *) my_malloc (STREAM_BUFFER);
+   s -> start = s -> stop = 0;
+   s -> end = FALSE;
+}
+
+/****************************************************************************************/
+
+static void close_stream (T_Stream *s)
+   /* closes the stream and its file */
+
+{
+   my_free (s -> buffer, STREAM_BUFFER);
+   close_input (s -> f);
+}
 
-   /* determine the floating point values of numerator and denominator */
-   numerator = 0;
-   for (i = 0; i < strlen (numerator_s); i++)
-   {  token = numerator_s [i];
-      if (strchr ("0123456789", token)) /* token is a cypher */
-         numerator = 10 * numerator + (int) token - 48;
+/****************************************************************************************/
+
+static real *read_matrix_stream (char *filename, int *rows, int *columns, int *data_type)
+   /* reads the matrix of the specified compressed file as described for "read_matrix" */
+   /* from the output of GZIP_EXEC, which decompresses the next part of the file while */
+   /* the current one is parsed                                                        */
+
+{  T_Stream   s;
+   const char *token;
+   long int   length, total, k;
+   real       *values;
+
+   open_stream (&s, open_input (filename));
+   if (!stream_header (&s, rows, columns, data_type))
+   {  fprintf (stderr, "\n***** ERROR: File '%s' in 'read_matrix' does not contain a line ",
+              filename);
+      fprintf (stderr, "'begin'\nfollowed by a header.\n");
+      exit (0);
    }
+   if (*rows <= 0 || *columns <= 1)
+   {  fprintf (stderr, "\n***** ERROR: The header of file '%s' in 'read_matrix' does not ",
+              filename);
+      fprintf (stderr, "describe a matrix.\n");
+      exit (0);
+   }
+   total = (long int) *rows * *columns;
+   values = (real *) my_malloc (total * sizeof (real));
 
-   if (position != NULL)
-   {  denominator = 0;
-      for (i = 0; i < strlen (denominator_s); i++)
-      {  token = denominator_s [i];
-         if (strchr ("0123456789", token)) /* token is a cypher */
-            denominator = 10 * denominator + (int) token - 48;
+   for (k = 0; k < total; k++)
+   {  if ((token = stream_token (&s, &length)) == NULL)
+      {  fprintf (stderr, "\n***** ERROR: File '%s' in 'read_matrix' ends before all %i rows ",
+                 filename, *rows);
+         fprintf (stderr, "have been read.\n");
+         exit (0);
+      }
+      if (scan_number (token, token + length, &(values [k])) != token + length)
+      {  fprintf (stderr, "\n***** ERROR: Entry %li of row %li of file '%s' in 'read_matrix' ",
+                 k % *columns + 1, k / *columns + 1, filename);
+         fprintf (stderr, "is not a number.\n");
+         exit (0);
       }
    }
-   else denominator = 1;
 
-   *value = sign * numerator / denominator;
+   close_stream (&s);
+   return values;
 }
 
 /****************************************************************************************/
 
-static void fread_rational_value (FILE *f, real *value)
-   /* reads a rational value from the specified file "f" and assigns it to "value"      */
+boolean read_header (char *filename, int *rows, int *columns, int *data_type)
+   /* reads the number of rows, the number of columns and the data type from the header */
+   /* of the specified file in the polyhedra format, which may be compressed by gzip;   */
+   /* returns FALSE and leaves the variables unchanged if the file does not exist or    */
+   /* does not contain a header                                                         */
+
+{  char       *s;
+   size_t     size;
+   const char *body;
+   int        r, c, t;
+   T_Stream   stream;
+   boolean    found;
+
+   if ((s = map_file (filename, &size)) == NULL)
+      return FALSE;
+   if (is_gzip (s, size))
+   {  munmap (s, size);
+      open_stream (&stream, open_input (filename));
+      found = stream_header (&stream, &r, &c, &t);
+      close_stream (&stream);
+      if (!found)
+         return FALSE;
+   }
+   else
+   {  body = scan_header (s, s + size, &r, &c, &t);
+      munmap (s, size);
+      if (body == NULL)
+         return FALSE;
+   }
+   *rows = r;
+   *columns = c;
+   *data_type = t;
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+typedef struct
+{  const char *start, *stop;
+      /* the part of the file treated by the thread; it begins and ends between tokens  */
+   long int   first, tokens, total;
+      /* the index of the first token of the part, the number of its tokens and the     */
+      /* number of tokens to be read from the whole file                                */
+   real       *values;
+      /* the tokens read from the whole file in their order                             */
+   long int   failed;
+      /* the index of the first token of the part which is not a number, or -1          */
+} T_ParseJob;
+
+/****************************************************************************************/
+
+static void *count_tokens (void *job)
+   /* counts the tokens in the part of the file of the job */
+
+{  T_ParseJob *j = (T_ParseJob *) job;
+   const char *s = j -> start;
+
+   j -> tokens = 0;
+   while (s < j -> stop)
+   {  while (s < j -> stop && IS_SPACE (*s))
+         s++;
+      if (s < j -> stop)
+      {  j -> tokens++;
+         while (s < j -> stop && !IS_SPACE (*s))
+            s++;
+      }
+   }
+   return NULL;
+}
+
+/****************************************************************************************/
+
+static void *parse_tokens (void *job)
+   /* reads the tokens in the part of the file of the job as numbers, as far as they  */
+   /* are among the first total ones                                                  */
+
+{  T_ParseJob *j = (T_ParseJob *) job;
+   const char *s = j -> start, *next;
+   long int   k = j -> first;
+
+   j -> failed = -1;
+   while (s < j -> stop && k < j -> total)
+   {  while (s < j -> stop && IS_SPACE (*s))
+         s++;
+      if (s < j -> stop)
+      {  next = scan_number (s, j -> stop, &(j -> values [k]));
+         if (next == NULL)
+         {  if (j -> failed < 0)
+               j -> failed = k;
+            while (s < j -> stop && !IS_SPACE (*s))
+               s++;
+         }
+         else
+            s = next;
+         k++;
+      }
+   }
+   return NULL;
+}
+
+/****************************************************************************************/
+
+static real *read_matrix_memory (const char *s, const char *end, char *name, int *rows,
+   int *columns, int *data_type)
+   /* reads the matrix in the polyhedra format from the memory between s and end as   */
+   /* described for "read_matrix"; name is used in the error messages                 */
+
+{  const char *body;
+   long int   total, tokens;
+   int        t, threads = G_Threads;
+   real       *values;
+   T_ParseJob *job;
+
+   if ((body = scan_header (s, end, rows, columns, data_type)) == NULL)
+   {  fprintf (stderr, "\n***** ERROR: File '%s' in 'read_matrix' does not contain a line ",
+              name);
+      fprintf (stderr, "'begin'\nfollowed by a header.\n");
+      exit (0);
+   }
+   if (*rows <= 0 || *columns <= 1)
+   {  fprintf (stderr, "\n***** ERROR: The header of file '%s' in 'read_matrix' does not ",
+              name);
+      fprintf (stderr, "describe a matrix.\n");
+      exit (0);
+   }
+   total = (long int) *rows * *columns;
+   values = (real *) my_malloc (total * sizeof (real));
+
+   if (threads > (end - body) / 4096 + 1)
+      threads = (end - body) / 4096 + 1;
+   job = (T_ParseJob *) my_malloc (threads * sizeof (T_ParseJob));
+   for (t = 0; t < threads; t++)
+   {  job [t].start = (t == 0 ? body : job [t-1].stop);
+      job [t].stop = body + (long int) (end - body) * (t + 1) / threads;
+      if (job [t].stop < job [t].start)
+         job [t].stop = job [t].start;
+      while (job [t].stop < end && !IS_SPACE (*(job [t].stop)))
+         job [t].stop++;
+      job [t].total = total;
+      job [t].values = values;
+   }
+   run_jobs (count_tokens, job, sizeof (T_ParseJob), threads);
+   for (t = 0, tokens = 0; t < threads; t++)
+   {  job [t].first = tokens;
+      tokens += job [t].tokens;
+   }
+   if (tokens < total)
+   {  fprintf (stderr, "\n***** ERROR: File '%s' in 'read_matrix' ends before all %i rows ",
+              name, *rows);
+      fprintf (stderr, "have been read.\n");
+      exit (0);
+   }
+   run_jobs (parse_tokens, job, sizeof (T_ParseJob), threads);
+   for (t = 0; t < threads; t++)
+      if (job [t].failed >= 0)
+      {  fprintf (stderr, "\n***** ERROR: Entry %li of row %li of file '%s' in 'read_matrix' ",
+                 job [t].failed % *columns + 1, job [t].failed / *columns + 1, name);
+         fprintf (stderr, "is not a number.\n");
+         exit (0);
+      }
+
+   my_free (job, threads * sizeof (T_ParseJob));
+   return values;
+}
+
+/****************************************************************************************/
+
+static real *read_matrix (char *filename, int *rows, int *columns, int *data_type)
+   /* reads the matrix of the specified file in the polyhedra format, returning its    */
+   /* entries row by row in a newly allocated array of rows * columns reals           */
+   /* The file is mapped into memory and split into G_Threads parts at whitespace;     */
+   /* the threads first count the tokens in their parts, which determines the index of */
+   /* the first token of each part, and then read them. Files compressed by gzip are   */
+   /* read by "read_matrix_stream" instead.                                            */
+
+{  char   *s;
+   size_t size;
+   real   *values;
+
+   if ((s = map_file (filename, &size)) == NULL)
+   {  fprintf (stderr, "\n***** ERROR: Could not open file '%s' in 'read_matrix'.\n", filename);
+      exit (0);
+   }
+   if (is_gzip (s, size))
+   {  munmap (s, size);
+      return read_matrix_stream (filename, rows, columns, data_type);
+   }
+   values = read_matrix_memory (s, s + size, filename, rows, columns, data_type);
+   munmap (s, size);
+   return values;
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
+
+static const char *next_block (const char *s, const char *end, int *type,
+   const char **block, const char **stop)
+   /* looks for the next matrix in the polyhedra format in the memory between s and   */
+   /* end; sets type to 'V' or 'H' according to the last line 'V-representation' or  */
+   /* 'H-representation' before its line 'begin', or to 0 if there is none, block to  */
+   /* the line 'begin' and stop to the following line starting with 'end' or to end.  */
+   /* Returns a pointer behind the line 'end', or NULL if there is no line 'begin'.   */
 
 {
-   char     number_s [255];
-   rational rational_value;
+   *type = 0;
+   while (s < end && (end - s < 5 || strncmp (s, "begin", 5)))
+   {  if (end - s >= 16 && !strncmp (s + 1, "-representation", 15)
+          && (*s == 'V' || *s == 'H'))
+         *type = *s;
+      while (s < end && *s != '\n')
+         s++;
+      if (s < end)
+         s++;
+   }
+   if (s == end)
+      return NULL;
+   *block = s;
+   while (s < end && (end - s < 3 || strncmp (s, "end", 3)))
+   {  while (s < end && *s != '\n')
+         s++;
+      if (s < end)
+         s++;
+   }
+   *stop = s;
+   while (s < end && *s != '\n')
+      s++;
+   return (s < end ? s + 1 : s);
+}
+
+/****************************************************************************************/
+
+const char *read_polytope_buffer (const char *s, const char *end, char *name, int *ext,
+   int *ine, int *d, int *m, int *n)
+   /* prepares reading the next polytope from the memory between s and end, which     */
+   /* contains matrices in the polyhedra format, each one preceded by a line           */
+   /* 'V-representation' or 'H-representation'. A polytope is given by a V- and an     */
+   /* H-representation of the same dimension in any order, or by only one of them if   */
+   /* the next matrix is of the same type or of a different dimension. The variables   */
+   /* are set as by 'existing_files', with NONE for a missing representation, and      */
+   /* until the next call 'read_vertices', 'read_hyperplanes' and 'read_polytope' take */
+   /* the polytope from the memory instead of the files; the memory must be kept       */
+   /* meanwhile. name is used in the error messages.                                   */
+   /* Returns a pointer behind the polytope, or NULL if there is none.                 */
 
-   fscanf (f, "%s ", number_s);
-   sread_rational_value (number_s, &rational_value);
-   *value = rational_value;
+{  const char *block, *stop, *next;
+   int        type, rows, columns, data_type;
 
+   vertex_block = planes_block = NULL;
+   *ext = *ine = NONE;
+   *d = *m = *n = 0;
+   while ((vertex_block == NULL || planes_block == NULL)
+          && (next = next_block (s, end, &type, &block, &stop)) != NULL)
+   {  if (type == 0)
+      {  fprintf (stderr, "\n***** ERROR: A matrix of '%s' in 'read_polytope_buffer' is ",
+                 name);
+         fprintf (stderr, "not preceded by\na line 'V-representation' or ");
+         fprintf (stderr, "'H-representation'.\n");
+         exit (0);
+      }
+      if (scan_header (block, stop, &rows, &columns, &data_type) == NULL)
+      {  fprintf (stderr, "\n***** ERROR: A matrix of '%s' in 'read_polytope_buffer' has ",
+                 name);
+         fprintf (stderr, "no header.\n");
+         exit (0);
+      }
+      if ((type == 'V' && vertex_block != NULL) || (type == 'H' && planes_block != NULL)
+          || (*d != 0 && *d != columns))
+         break;
+      *d = columns;
+      if (type == 'V')
+      {  vertex_block = block;
+         vertex_end = stop;
+         *ext = data_type;
+         *n = rows;
+      }
+      else
+      {  planes_block = block;
+         planes_end = stop;
+         *ine = data_type;
+         *m = rows;
+      }
+      s = next;
+   }
+
+   buffer_name = name;
+   buffer_input = (vertex_block != NULL || planes_block != NULL);
+   return (buffer_input ? s : NULL);
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
+
+char *read_whole_file (FILE *f, long int *size)
+   /* reads everything from f up to its end into a newly allocated buffer, which is    */
+   /* terminated by a zero byte, and sets size to the number of bytes read; the buffer */
+   /* is freed by my_free (buffer, size + 1)                                           */
+
+{  char     *buffer;
+   long int allocated = STREAM_BUFFER;
+   size_t   got;
+
+   buffer = (char *) my_malloc (allocated);
+   *size = 0;
+   while ((got = fread (buffer + *size, 1, allocated - 1 - *size, f)) > 0)
+   {  *size += got;
+      if (*size == allocated - 1)
+      {  buffer = (char *) my_realloc (buffer, 2 * allocated, allocated);
+         allocated *= 2;
+      }
+   }
+   buffer [*size] = '\0';
+   return (char *) my_realloc (buffer, *size + 1, *size + 1 - allocated);
 }
 
 /****************************************************************************************/
@@ -143,18 +848,25 @@ void read_vertices (char filename [255])
    /*   ...                                                                             */
    /* 1   vn                                                                            */
    /* end or any other text (is ignored)                                                */
+   /* If G_BinaryFile is set, the vertices are taken from it instead, and after a call  */
+   /* of 'read_polytope_buffer' from the memory given there.                            */
 
-{  FILE     *f;
-   int      i, j;
+{  int      i, columns, data_type;
    T_Vertex *v;
-   char     data_type_string [255];
-   int      data_type;
+   real     *values;
+
+   if (G_BinaryFile != NULL)
+   {  binary_vertices ();
+      return;
+   }
 
    G_Vertices = create_empty_set ();
-   f = open_read (filename);
-   fscanf (f, "%i %i %s ", &G_n, &G_d, data_type_string);
-   G_d --;
-   data_type = determine_data_type (data_type_string);
+   if (buffer_input)
+      values = read_matrix_memory (vertex_block, vertex_end, buffer_name, &G_n, &columns,
+                                   &data_type);
+   else
+      values = read_matrix (filename, &G_n, &columns, &data_type);
+   G_d = columns - 1;
    if (data_type == RATIONAL_T)
    {  fprintf (stderr, "\n***** WARNING: The vertex file is of rational type; the ");
       fprintf (stderr, "vertex coordinates\nwill be transformed to floating point ");
@@ -163,17 +875,12 @@ void read_vertices (char filename [255])
 
    for (i = 0; i < G_n; i++)
    {  v = create_vertex ();
-      fscanf (f, "%*i "); /* skips the entry one */
       v -> no = i; /* this assures v to be added at the end of the list */
-      if (data_type == REAL_T)
-         for (j = 0; j < G_d; j++)
-            fscanf (f, "%lg ", &(v -> coords [j]));
-      else
-         for (j = 0; j < G_d; j++)
-            fread_rational_value (f, &(v -> coords [j]));
+      /* skips the entry one */
+      memcpy (v -> coords, values + (long int) i * columns + 1, G_d * sizeof (real));
       add_element (&G_Vertices, v);
    };
-   fclose (f);
+   my_free (values, (long int) G_n * columns * sizeof (real));
 }
 
 /****************************************************************************************/
@@ -188,17 +895,23 @@ void read_hyperplanes (char filename [255])
    /* number of hyperplanes m  dimension + 1   type of coordinates                      */
    /* b   -A                                                                            */
    /* end or any other text (is ignored)                                                */
+   /* If G_BinaryFile is set, the hyperplanes are taken from it instead, and after a    */
+   /* call of 'read_polytope_buffer' from the memory given there.                       */
 
-{  FILE       *f;
-   int        i, j;
-   char       data_type_string [255];
-   int        data_type;
+{  int  i, j, columns, data_type;
+   real *values, *row;
 
+   if (G_BinaryFile != NULL)
+   {  binary_hyperplanes ();
+      return;
+   }
 
-   f = open_read (filename);
-   fscanf (f, "%i %i %s ", &G_m, &G_d, data_type_string);
-   G_d --;
-   data_type = determine_data_type (data_type_string);
+   if (buffer_input)
+      values = read_matrix_memory (planes_block, planes_end, buffer_name, &G_m, &columns,
+                                   &data_type);
+   else
+      values = read_matrix (filename, &G_m, &columns, &data_type);
+   G_d = columns - 1;
    if (data_type == RATIONAL_T)
    {  fprintf (stderr, "\n***** WARNING: The planes file is of rational type; all ");
       fprintf (stderr, "coordinates will be\ntransformed to floating point values.\n");
@@ -206,24 +919,13 @@ void read_hyperplanes (char filename [255])
 
    create_hyperplanes ();
 
-   if (data_type == REAL_T)
-      for (i = 0; i < G_m; i++)
-      {  fscanf (f, "%le ", &(G_Hyperplanes [i] [G_d]));
-         for (j = 0; j < G_d; j++)
-         {  fscanf (f, "%le ", &(G_Hyperplanes [i] [j]));
-            G_Hyperplanes [i] [j] = - G_Hyperplanes [i] [j];
-         }
-      }
-   else
-      for (i = 0; i < G_m; i++)
-      {  fread_rational_value (f, &(G_Hyperplanes [i] [G_d]));
-         for (j = 0; j < G_d; j++)
-         {  fread_rational_value (f, &(G_Hyperplanes [i] [j]));
-            G_Hyperplanes [i] [j] = - G_Hyperplanes [i] [j];
-         }
-      }
-
-   fclose (f);
+   for (i = 0; i < G_m; i++)
+   {  row = values + (long int) i * columns;
+      G_Hyperplanes [i] [G_d] = row [0];
+      for (j = 0; j < G_d; j++)
+         G_Hyperplanes [i] [j] = - row [j + 1];
+   }
+   my_free (values, (long int) G_m * columns * sizeof (real));
 }
 
 /****************************************************************************************/
@@ -252,5 +954,460 @@ void compute_incidence ()
 
 }
 
+/****************************************************************************************/
+
+void write_vertices (char *filename)
+   /* writes G_Vertices to the specified file in the polyhedra format described for     */
+   /* "read_vertices"                                                                   */
+
+{  FILE *f;
+   int  i, j;
+
+   if (! (f = fopen (filename, "w")))
+   {  fprintf (stderr, "\n***** ERROR: Could not open file '%s' in 'write_vertices'.\n",
+              filename);
+      exit (0);
+   }
+   fprintf (f, "V-representation\nbegin\n%i %i real\n", G_n, G_d + 1);
+   for (i = 0; i < G_n; i++)
+   {  fprintf (f, "1");
+      for (j = 0; j < G_d; j++)
+         fprintf (f, " %.17g", G_Vertices.loe [i] -> coords [j]);
+      fprintf (f, "\n");
+   }
+   fprintf (f, "end\n");
+   fclose (f);
+}
+
+/****************************************************************************************/
+
+void write_hyperplanes (char *filename)
+   /* writes G_Hyperplanes to the specified file in the polyhedra format described for  */
+   /* "read_hyperplanes"                                                                */
+
+{  FILE *f;
+   int  i, j;
+
+   if (! (f = fopen (filename, "w")))
+   {  fprintf (stderr, "\n***** ERROR: Could not open file '%s' in 'write_hyperplanes'.\n",
+              filename);
+      exit (0);
+   }
+   fprintf (f, "H-representation\nbegin\n%i %i real\n", G_m, G_d + 1);
+   for (i = 0; i < G_m; i++)
+   {  fprintf (f, "%.17g", G_Hyperplanes [i] [G_d]);
+      for (j = 0; j < G_d; j++)
+         fprintf (f, " %.17g", - G_Hyperplanes [i] [j]);
+      fprintf (f, "\n");
+   }
+   fprintf (f, "end\n");
+   fclose (f);
+}
+
+/****************************************************************************************/
+
+static void enumerate_vertices ()
+   /* determines G_Vertices and G_n from G_Hyperplanes by the double description method */
+   /* and writes the vertices to G_ExtFile if it is set                                 */
+
+{  rational **X;
+   T_Vertex *v;
+   int      i;
+
+   G_n = dd_vertices (G_Hyperplanes, G_m, &X);
+   if (G_n < 0)
+   {  fprintf (stderr, "\n***** ERROR: The polyhedron is empty or unbounded in 'enumerate_vertices'.\n");
+      exit (0);
+   }
+
+   G_Vertices = create_empty_set ();
+   for (i = 0; i < G_n; i++)
+   {  v = create_vertex ();
+      v -> no = i;
+      memcpy (v -> coords, X [i], G_d * sizeof (rational));
+      add_element (&G_Vertices, v);
+   }
+   free_matrix (X, G_n, G_d);
+   printf ("\n%i vertices have been enumerated from the hyperplanes.", G_n);
+
+   if (G_ExtFile != NULL)
+   {  write_vertices (G_ExtFile);
+      printf ("\nThe vertices have been written to '%s'.", G_ExtFile);
+   }
+   printf ("\n");
+}
+
+/****************************************************************************************/
+
+static boolean is_vertex (T_Vertex *v, real **U)
+   /* checks whether the hyperplanes containing v have rank G_d, i.e. whether v is a    */
+   /* vertex of the polytope; the rows of U are used for orthogonalising their normals  */
+
+{  int  i, j, k, found = 0;
+   real diff, norm;
+
+   for (j = 0; j < G_m && found < G_d; j++)
+   {  diff = G_Hyperplanes [j] [G_d];
+      for (k = 0; k < G_d; k++)
+         diff -= v -> coords [k] * G_Hyperplanes [j] [k];
+      if (fabs (diff) < INCIDENCE_EPSILON)
+      {  for (k = 0; k < G_d; k++)
+            U [found] [k] = G_Hyperplanes [j] [k];
+         for (i = 0; i < found; i++)
+         {  norm = 0;
+            for (k = 0; k < G_d; k++)
+               norm += U [found] [k] * U [i] [k];
+            for (k = 0; k < G_d; k++)
+               U [found] [k] -= norm * U [i] [k];
+         }
+         norm = 0;
+         for (k = 0; k < G_d; k++)
+            norm += U [found] [k] * U [found] [k];
+         if (norm > DD_EPSILON)
+         {  norm = sqrt (norm);
+            for (k = 0; k < G_d; k++)
+               U [found] [k] /= norm;
+            found++;
+         }
+      }
+   }
+   return (found == G_d);
+}
+
+/****************************************************************************************/
+
+static void enumerate_hyperplanes ()
+   /* determines G_Hyperplanes and G_m as the facets of the convex hull of the points   */
+   /* in G_Vertices; points which are not vertices of the hull and duplicates are       */
+   /* removed from G_Vertices, and the hyperplanes are written to G_IneFile if it is    */
+   /* set                                                                               */
+
+{  rational    **points, **U;
+   boolean     *extreme;
+   T_VertexSet vertices;
+   T_Vertex    *v;
+   int         i, n;
+
+   points = (rational **) my_malloc (G_n * sizeof (rational *));
+   for (i = 0; i < G_n; i++)
+      points [i] = G_Vertices.loe [i] -> coords;
+   extreme = (boolean *) my_malloc (G_n * sizeof (boolean));
+   G_m = convex_hull (points, G_n, &U, extreme);
+   my_free (points, G_n * sizeof (rational *));
+   if (G_m < 0)
+   {  fprintf (stderr, "\n***** ERROR: The points do not span a full-dimensional polytope in ");
+      fprintf (stderr, "'enumerate_hyperplanes'.\n");
+      exit (0);
+   }
+   create_hyperplanes ();
+   for (i = 0; i < G_m; i++)
+      memcpy (G_Hyperplanes [i], U [i], (G_d + 1) * sizeof (rational));
+   free_matrix (U, G_m, G_d + 1);
+
+   /* keep only the vertices, numbered consecutively; points closer than               */
+   /* INCIDENCE_EPSILON to a previous one are never marked as extreme                   */
+   U = create_matrix (G_d, G_d);
+   vertices = create_empty_set ();
+   n = 0;
+   for (i = 0; i < G_n; i++)
+   {  v = G_Vertices.loe [i];
+      if (extreme [i] && is_vertex (v, U))
+      {  v -> no = n++;
+         add_element (&vertices, v);
+      }
+      else
+         free_vertex (v);
+   }
+   free_matrix (U, G_d, G_d);
+   my_free (extreme, G_n * sizeof (boolean));
+   free_set (G_Vertices);
+   G_Vertices = vertices;
+   printf ("\n%i facets have been computed from the %i points, of which %i are vertices.",
+           G_m, G_n, n);
+   G_n = n;
+
+   if (G_IneFile != NULL)
+   {  write_hyperplanes (G_IneFile);
+      printf ("\nThe hyperplanes have been written to '%s'.", G_IneFile);
+   }
+   printf ("\n");
+}
+
+/****************************************************************************************/
+
+unsigned long int hash_memory (const char *s, long int size, unsigned long int hash)
+   /* continues the 32 bit Fowler-Noll-Vo hash value (FNV-1a) with the given bytes; a  */
+   /* new hash value starts with HASH_START                                            */
+
+{  long int i;
+
+   for (i = 0; i < size; i++)
+      hash = ((hash ^ (unsigned char) s [i]) * 16777619UL) & 0xffffffffUL;
+   return hash;
+}
+
+/****************************************************************************************/
+
+static unsigned long int continue_hash (char *filename, unsigned long int hash)
+   /* continues the hash value with the contents of the file                           */
+
+{  FILE   *f;
+   char   *s;
+   size_t size;
+
+   if (! (f = fopen (filename, "rb")))
+   {  fprintf (stderr, "\n***** ERROR: Could not open file '%s' in 'hash_file'.\n", filename);
+      exit (0);
+   }
+   fclose (f);
+   /* an empty file is not mapped */
+   if ((s = map_file (filename, &size)) != NULL)
+   {  hash = hash_memory (s, (long int) size, hash);
+      munmap (s, size);
+   }
+   return hash;
+}
+
+/****************************************************************************************/
+
+unsigned long int hash_polytope (char *vertexfile, char *planesfile)
+   /* returns a hash value of the contents of the existing ones among the vertex and    */
+   /* the planes file, or 0 if neither of them exists                                   */
+
+{  FILE              *f;
+   boolean           vertices, planes;
+   unsigned long int hash = HASH_START;
+
+   if ((vertices = ((f = fopen (vertexfile, "rb")) != NULL)))
+      fclose (f);
+   if ((planes = ((f = fopen (planesfile, "rb")) != NULL)))
+      fclose (f);
+   if (!vertices && !planes)
+      return 0;
+
+   if (vertices)
+      hash = continue_hash (vertexfile, hash);
+   /* a separator, so that an .ext-file alone differs from the same .ine-file alone */
+   hash = hash_memory ("|", 1, hash);
+   if (planes)
+      hash = continue_hash (planesfile, hash);
+   return hash;
+}
+
+/****************************************************************************************/
+
+static void cached_incidence (char *vertexfile, char *planesfile)
+   /* computes the incidence as 'compute_incidence'; for big polytopes, it is stored in */
+   /* a file with the extension '.icb' next to the vertex file, together with the hash  */
+   /* value of the vertex and the planes file given by 'hash_polytope', and taken from  */
+   /* there by later runs on the same files                                             */
+
+{  char              icbfile [255];
+   unsigned long int hash;
+
+   if ((double) G_n * G_m * G_d < INCIDENCE_CACHE)
+   {  compute_incidence ();
+      return;
+   }
+
+   /* the vertex file name ends with '.ext' */
+   strcpy (icbfile, vertexfile);
+   strcpy (icbfile + strlen (icbfile) - 4, ".icb");
+   hash = hash_polytope (vertexfile, planesfile);
+
+   if (read_incidence (icbfile, hash))
+      printf ("\nThe incidence is read from '%s'.\n", icbfile);
+   else
+   {  compute_incidence ();
+      write_incidence (icbfile, hash);
+   }
+}
+
+/****************************************************************************************/
+
+void read_polytope (char *vertexfile, char *planesfile)
+   /* reads the vertices and the hyperplanes and computes their incidence; if the       */
+   /* vertex file does not exist, the vertices are enumerated from the hyperplanes, and */
+   /* if the planes file does not exist, the facets are computed from the vertices.     */
+   /* If a binary file is used, everything is taken from there; after a call of        */
+   /* 'read_polytope_buffer', the representations given in the memory are used. The    */
+   /* incidence of big polytopes read from files is cached, see 'cached_incidence'.     */
+
+{  FILE    *f;
+   boolean vertices, planes;
+
+   if (G_BinaryFile != NULL)
+   {  binary_vertices ();
+      binary_hyperplanes ();
+      if (!binary_incidence ())
+         compute_incidence ();
+      return;
+   }
+   if (buffer_input)
+   {  vertices = (vertex_block != NULL);
+      planes = (planes_block != NULL);
+   }
+   else
+   {  if ((vertices = ((f = fopen (vertexfile, "r")) != NULL)))
+         fclose (f);
+      if ((planes = ((f = fopen (planesfile, "r")) != NULL)))
+         fclose (f);
+   }
+   if (vertices)
+   {  read_vertices (vertexfile);
+      if (planes)
+         read_hyperplanes (planesfile);
+      else
+         enumerate_hyperplanes ();
+   }
+   else
+   {  read_hyperplanes (planesfile);
+      enumerate_vertices ();
+   }
+   if (buffer_input)
+      compute_incidence ();
+   else
+      cached_incidence (vertexfile, planesfile);
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
+
+/****************************************************************************************/
+
+static void feed_lrs (int fd, char *filename, char *head, char *tail)
+   /* writes the input for lrs to the file descriptor fd: if head is NULL, the whole   */
+   /* file, otherwise head followed by the lines of the file up to the line 'end',     */
+   /* and then tail                                                                     */
+
+{  FILE *in, *out;
+   char line [255];
+
+   if (! (out = fdopen (fd, "w")))
+      _exit (1);
+   if (head == NULL)
+   {  if (! (in = open_input (filename)))
+      {  fprintf (stderr, "\n***** ERROR: Could not open file '%s' in 'feed_lrs'.\n",
+                  filename);
+         _exit (1);
+      }
+      while (fgets (line, 255, in) != NULL)
+         fputs (line, out);
+   }
+   else
+   {  in = open_read (filename);
+      fputs (head, out);
+      while (fgets (line, 255, in) != NULL && strncmp (line, "end", 3))
+         fputs (line, out);
+   }
+   close_input (in);
+   fputs (tail, out);
+   fclose (out);
+   _exit (0);
+}
+
+/****************************************************************************************/
+
+boolean lrs_exists ()
+   /* tells whether "open_lrs" finds LRS_EXEC, that is, whether it is executable       */
+   /* relative to the working directory or in one of the directories of the            */
+   /* search path (by default "/bin:/usr/bin" as for execlp).                          */
+
+{  char   *path = getenv ("PATH"), file [1024];
+   size_t length;
+
+   if (access (LRS_EXEC, X_OK) == 0)
+      return TRUE;
+   if (path == NULL)
+      path = "/bin:/usr/bin";
+   while (*path != '\0')
+   {  length = strcspn (path, ":");
+      if (length + strlen (LRS_EXEC) + 2 <= sizeof (file))
+      {  /* an empty directory stands for the working directory */
+         memcpy (file, path, length);
+         file [length] = '/';
+         strcpy (file + (length == 0 ? 0 : length + 1), LRS_EXEC);
+         if (access (file, X_OK) == 0)
+            return TRUE;
+      }
+      path += length;
+      if (*path == ':')
+         path++;
+   }
+   return FALSE;
+}
+
+/****************************************************************************************/
+
+FILE * open_lrs (char *filename, char *head, char *tail)
+   /* starts lrs in a child process and returns its standard output as a stream. Its   */
+   /* input, composed as described for "feed_lrs", is written by a second child        */
+   /* process, so that lrs may produce its output while it is read. No temporary files */
+   /* are written. LRS_EXEC is looked up relative to the working directory and then    */
+   /* in the search path, as by "lrs_exists".                                          */
+
+{  int  input [2], output [2];
+   FILE *f;
+
+   fflush (stdout);
+   if (pipe (input) != 0 || pipe (output) != 0)
+   {  fprintf (stderr, "\n***** ERROR: Could not create a pipe in 'open_lrs'.\n");
+      exit (0);
+   }
+
+   lrs_pid = fork ();
+   if (lrs_pid == 0)
+   {  dup2 (input [0], 0);
+      dup2 (output [1], 1);
+      close (input [0]);
+      close (input [1]);
+      close (output [0]);
+      close (output [1]);
+      execl (LRS_EXEC, LRS_EXEC, (char *) NULL);
+      execlp (LRS_EXEC, LRS_EXEC, (char *) NULL);
+      fprintf (stderr, "\n***** ERROR: Could not execute '%s' in 'open_lrs'.\n", LRS_EXEC);
+      _exit (1);
+   }
+   close (input [0]);
+   close (output [1]);
+
+   feeder_pid = fork ();
+   if (feeder_pid == 0)
+   {  close (output [0]);
+      feed_lrs (input [1], filename, head, tail);
+   }
+   close (input [1]);
+
+   if (lrs_pid < 0 || feeder_pid < 0 || ! (f = fdopen (output [0], "r")))
+   {  fprintf (stderr, "\n***** ERROR: Could not start '%s' in 'open_lrs'.\n", LRS_EXEC);
+      exit (0);
+   }
+   return f;
+}
+
+/****************************************************************************************/
+
+boolean close_lrs (FILE *f)
+   /* closes the output of lrs opened by "open_lrs" and waits for the child processes; */
+   /* returns whether lrs has terminated normally                                      */
+
+{  int status;
+
+   fclose (f);
+   waitpid (feeder_pid, NULL, 0);
+   if (waitpid (lrs_pid, &status, 0) != lrs_pid)
+      return FALSE;
+   return (WIFEXITED (status) && WEXITSTATUS (status) == 0);
+}
+
+/****************************************************************************************/
+
+unsigned long int hash_file (char *filename)
+   /* returns the hash value of the contents of the file                               */
+
+{
+   return continue_hash (filename, HASH_START);
+}
+
 /****************************************************************************************/
 /****************************************************************************************/
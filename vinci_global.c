@@ -33,6 +33,24 @@ T_VertexSet G_Vertices;
 
 int G_Storage = -1;
 int G_RandomSeed = 4;
+int G_Threads = 1;
+int G_Objectives = 1;
+int G_Precision = PRECISION_DOUBLE;
+int G_Order = -1;
+char *G_SymmetryFile = NULL;
+char *G_DumpFile = NULL;
+int G_DumpDim = -1;
+boolean G_Session = FALSE;
+char *G_TriangulationFile = NULL;
+char *G_SampleFile = NULL;
+long int G_SampleSize = -1;
+int G_Moments = -1;
+char *G_CacheFile = NULL;
+long int G_CacheMemory = -1;
+char *G_ExtFile = NULL;
+char *G_IneFile = NULL;
+char *G_BinaryFile = NULL;
+boolean G_Convert = FALSE;
 
 rational G_Minus1 = -1;
 
@@ -0,0 +1,633 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                    vinci_hull.c                                      */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* Authors: Benno Bueeler (bueeler@ifor.math.ethz.ch)                                   */
+/*          and                                                                         */
+/*          Andreas Enge (enge@ifor.math.ethz.ch)                                       */
+/*          Institute for Operations Research                                           */
+/*	    Swiss Federal Institute of Technology Zurich                                */
+/*	    Switzerland                                                                 */
+/*                                                                                      */
+/* Last Changes: October 19, 2026                                                       */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* facet enumeration by the Quickhull algorithm                                         */
+/*                                                                                      */
+/****************************************************************************************/
+
+#include "vinci.h"
+
+/* Starting with a simplex spanned by G_d + 1 of the points, each point lying beyond    */
+/* the current hull is attached to one of the facets it sees. The furthest point of a   */
+/* facet is then added to the hull by replacing all facets visible from it by the cone  */
+/* over their horizon, and the points attached to the removed facets are distributed    */
+/* among the new ones. The facets are simplices spanned by G_d points.                  */
+/* Points closer than INCIDENCE_EPSILON to a facet are considered as lying in it, so    */
+/* that the facets of degenerate inputs, in which many points lie in a common           */
+/* hyperplane, are split into simplices without creating spurious ones; finally the     */
+/* simplices lying in a common hyperplane are merged.                                   */
+
+typedef struct
+{  int     *vertex;
+      /* the G_d points spanning the facet */
+   int     *neighbour;
+      /* neighbour [i] is the facet sharing the ridge opposite to vertex [i] */
+   real    *normal, offset, size;
+      /* the facet lies in {x : normal x = offset}; the normal has length one and      */
+      /* points outwards. size is proportional to the volume of the simplex.           */
+   int     *outside, outsides, maxoutside;
+      /* the points beyond the facet which are attached to it */
+   int     furthest;
+   real    distance;
+      /* the attached point furthest from the facet and its distance */
+   int     visited;
+   boolean visible, alive;
+      /* the last step in which the facet has been visited, whether it is visible from  */
+      /* the point added in this step and whether it still belongs to the hull         */
+} T_Facet;
+
+typedef struct
+{  int facet, index, *key;
+} T_Ridge;
+   /* the ridge opposite to vertex [index] of a new facet; key contains the points     */
+   /* spanning it apart from the apex in increasing order                              */
+
+static real    **point;
+static boolean *candidate, *duplicate;
+   /* the points which may be vertices of the hull, and those which are left out       */
+   /* because they are closer than INCIDENCE_EPSILON to a previous one                 */
+static real    *centre;
+   /* a point in the interior of the hull */
+static T_Facet *facet;
+static int     facets, maxfacets;
+static real    **Q;
+   /* working space for orthogonalising */
+
+/****************************************************************************************/
+
+static real height (int f, int p)
+   /* returns the signed distance of point p from the hyperplane of facet f */
+
+{  int  j;
+   real sum = - facet [f].offset;
+
+   for (j = 0; j < G_d; j++)
+      sum += facet [f].normal [j] * point [p] [j];
+   return sum;
+}
+
+/****************************************************************************************/
+
+static real orthogonalise (real *x, int k)
+   /* orthogonalises x against the orthonormal rows 0 to k-1 of Q and returns its norm */
+
+{  int  i, j;
+   real product, norm = 0;
+
+   for (i = 0; i < k; i++)
+   {  product = 0;
+      for (j = 0; j < G_d; j++)
+         product += x [j] * Q [i] [j];
+      for (j = 0; j < G_d; j++)
+         x [j] -= product * Q [i] [j];
+   }
+   for (j = 0; j < G_d; j++)
+      norm += x [j] * x [j];
+   return sqrt (norm);
+}
+
+/****************************************************************************************/
+
+static int new_facet ()
+   /* reserves space for one more facet and returns its index */
+
+{  int f;
+
+   if (facets == maxfacets)
+   {  facet = (T_Facet *) my_realloc (facet, 2 * maxfacets * sizeof (T_Facet),
+                                      maxfacets * sizeof (T_Facet));
+      maxfacets *= 2;
+   }
+   f = facets++;
+   facet [f].vertex = create_int_vector (G_d);
+   facet [f].neighbour = create_int_vector (G_d);
+   facet [f].normal = create_vector ();
+   facet [f].outside = NULL;
+   facet [f].outsides = 0;
+   facet [f].maxoutside = 0;
+   facet [f].furthest = -1;
+   facet [f].distance = 0;
+   facet [f].visited = 0;
+   facet [f].visible = FALSE;
+   facet [f].alive = TRUE;
+   return f;
+}
+
+/****************************************************************************************/
+
+static void remove_facet (int f)
+   /* removes the facet from the hull */
+
+{
+   free_int_vector (facet [f].vertex, G_d);
+   free_int_vector (facet [f].neighbour, G_d);
+   free_vector (facet [f].normal);
+   if (facet [f].maxoutside > 0)
+      my_free (facet [f].outside, facet [f].maxoutside * sizeof (int));
+   facet [f].alive = FALSE;
+}
+
+/****************************************************************************************/
+
+static void compute_hyperplane (int f)
+   /* determines the outer normal and the offset of facet f; if one of its points lies  */
+   /* closer than INCIDENCE_EPSILON to the affine hull of the previous ones, the size   */
+   /* of the facet is set to 0, and its hyperplane is not reliable                      */
+
+{  int     j, k;
+   real    norm, *normal = facet [f].normal, *v0 = point [facet [f].vertex [0]];
+   boolean degenerate = FALSE;
+
+   facet [f].size = 1;
+   for (k = 1; k < G_d; k++)
+   {  for (j = 0; j < G_d; j++)
+         Q [k-1] [j] = point [facet [f].vertex [k]] [j] - v0 [j];
+      norm = orthogonalise (Q [k-1], k - 1);
+      if (norm <= INCIDENCE_EPSILON)
+         degenerate = TRUE;
+      if (norm > 0)
+         for (j = 0; j < G_d; j++)
+            Q [k-1] [j] /= norm;
+      facet [f].size *= norm;
+   }
+   if (degenerate)
+      facet [f].size = 0;
+   /* the component of v0 - centre orthogonal to the facet points outwards */
+   for (j = 0; j < G_d; j++)
+      normal [j] = v0 [j] - centre [j];
+   norm = orthogonalise (normal, G_d - 1);
+   facet [f].offset = 0;
+   for (j = 0; j < G_d; j++)
+   {  normal [j] /= norm;
+      facet [f].offset += normal [j] * v0 [j];
+   }
+}
+
+/****************************************************************************************/
+
+static void attach (int p, int first)
+   /* attaches the point p to the first facet with index at least first which it lies */
+   /* beyond; if there is none, p lies in the current hull. If it is close to one of  */
+   /* the facets, it may still be a vertex and is marked as a candidate.              */
+
+{  int  f, size;
+   real dist;
+
+   for (f = first; f < facets; f++)
+      if (facet [f].alive && (dist = height (f, p)) > - INCIDENCE_EPSILON)
+      {  if (dist <= INCIDENCE_EPSILON)
+         {  candidate [p] = TRUE;
+            continue;
+         }
+         if (facet [f].outsides == facet [f].maxoutside)
+         {  size = facet [f].maxoutside;
+            facet [f].maxoutside = (size == 0 ? 4 : 2 * size);
+            facet [f].outside = (int *) my_realloc (facet [f].outside,
+                                   facet [f].maxoutside * sizeof (int),
+                                   (facet [f].maxoutside - size) * sizeof (int));
+         }
+         facet [f].outside [facet [f].outsides++] = p;
+         if (dist > facet [f].distance)
+         {  facet [f].furthest = p;
+            facet [f].distance = dist;
+         }
+         return;
+      }
+}
+
+/****************************************************************************************/
+
+static boolean initial_simplex (int n)
+   /* creates the facets of a simplex spanned by G_d + 1 of the points, each one being  */
+   /* furthest from the affine hull of the previous ones, and sets centre to its        */
+   /* barycentre. If the points are not full-dimensional, FALSE is returned and no      */
+   /* facet is created.                                                                 */
+
+{  int  i, j, k, p, best = 0, *simplex;
+   real norm, max;
+
+   simplex = create_int_vector (G_d + 1);
+   for (p = 1; p < n; p++)
+      if (point [p] [0] < point [best] [0])
+         best = p;
+   simplex [0] = best;
+   for (k = 0; k < G_d; k++)
+   {  max = 0;
+      for (p = 0; p < n; p++)
+      {  for (j = 0; j < G_d; j++)
+            Q [k] [j] = point [p] [j] - point [simplex [0]] [j];
+         if ((norm = orthogonalise (Q [k], k)) > max)
+         {  max = norm;
+            best = p;
+         }
+      }
+      if (max <= INCIDENCE_EPSILON)
+      {  free_int_vector (simplex, G_d + 1);
+         return FALSE;
+      }
+      simplex [k+1] = best;
+      for (j = 0; j < G_d; j++)
+         Q [k] [j] = point [best] [j] - point [simplex [0]] [j];
+      norm = orthogonalise (Q [k], k);
+      for (j = 0; j < G_d; j++)
+         Q [k] [j] /= norm;
+   }
+
+   for (j = 0; j < G_d; j++)
+   {  centre [j] = 0;
+      for (k = 0; k <= G_d; k++)
+         centre [j] += point [simplex [k]] [j];
+      centre [j] /= G_d + 1;
+   }
+
+   /* facet i is opposite to simplex [i] and meets facet k in the ridge opposite to */
+   /* simplex [k]                                                                   */
+   for (i = 0; i <= G_d; i++)
+   {  new_facet ();
+      for (k = 0, j = 0; k <= G_d; k++)
+         if (k != i)
+         {  facet [i].vertex [j] = simplex [k];
+            facet [i].neighbour [j++] = k;
+         }
+      compute_hyperplane (i);
+   }
+
+   free_int_vector (simplex, G_d + 1);
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+static int compare_ints (const void *p, const void *q)
+
+{
+   return (*(const int *) p - *(const int *) q);
+}
+
+/****************************************************************************************/
+
+static int compare_ridges (const void *r1, const void *r2)
+   /* compares the keys of two ridges lexicographically */
+
+{  int i, *k1 = ((T_Ridge *) r1) -> key, *k2 = ((T_Ridge *) r2) -> key;
+
+   for (i = 0; i < G_d - 2; i++)
+      if (k1 [i] != k2 [i])
+         return (k1 [i] < k2 [i] ? -1 : 1);
+   return 0;
+}
+
+/****************************************************************************************/
+
+static int *append (int *list, int *length, int *size, int x)
+   /* appends x to the list of the given length, which is doubled in size if it is full */
+
+{
+   if (*length == *size)
+   {  list = (int *) my_realloc (list, 2 * *size * sizeof (int), *size * sizeof (int));
+      *size *= 2;
+   }
+   list [(*length)++] = x;
+   return list;
+}
+
+/****************************************************************************************/
+
+static boolean add_point (int p, int f, int step)
+   /* adds point p, which lies beyond facet f, to the hull; returns FALSE if the        */
+   /* horizon is not a manifold                                                         */
+
+{  int     i, j, k, l, r, v, g, nb, first = facets, searched = 0, visibles = 0,
+           horizons, ridges = 0, maxvisibles = G_d, maxhorizon = 2 * G_d,
+           *visible, *horizon, *keys = NULL;
+   boolean ok = FALSE, extended = TRUE;
+   T_Ridge *ridge = NULL;
+
+   visible = create_int_vector (maxvisibles);
+   horizon = create_int_vector (maxhorizon);
+   facet [f].visited = step;
+   facet [f].visible = TRUE;
+   visible = append (visible, &visibles, &maxvisibles, f);
+   while (!ok && extended)
+   {  /* find the facets visible from p by a depth first search */
+      for (k = searched; k < visibles; k++)
+      {  v = visible [k];
+         for (i = 0; i < G_d; i++)
+         {  nb = facet [v].neighbour [i];
+            if (facet [nb].visited != step)
+            {  facet [nb].visited = step;
+               facet [nb].visible = (height (nb, p) > INCIDENCE_EPSILON);
+               if (facet [nb].visible)
+                  visible = append (visible, &visibles, &maxvisibles, nb);
+            }
+         }
+      }
+      searched = visibles;
+
+      /* the ridges between visible and invisible facets form the horizon; the cone   */
+      /* over it replaces vertex [i] of the visible facet by p, and its remaining     */
+      /* ridges are matched in pairs by sorting their points apart from p             */
+      horizons = 0;
+      for (k = 0; k < visibles; k++)
+         for (i = 0; i < G_d; i++)
+            if (!facet [facet [visible [k]].neighbour [i]].visible)
+            {  horizon = append (horizon, &horizons, &maxhorizon, visible [k]);
+               horizon = append (horizon, &horizons, &maxhorizon, i);
+            }
+      horizons /= 2;
+      ridges = horizons * (G_d - 1);
+      ridge = (T_Ridge *) my_malloc (ridges * sizeof (T_Ridge));
+      keys = create_int_vector (ridges * (G_d - 2) + 1);
+      for (k = 0, r = 0; k < horizons; k++)
+      {  v = horizon [2 * k];
+         i = horizon [2 * k + 1];
+         for (j = 0; j < G_d; j++)
+            if (j != i)
+            {  ridge [r].facet = k;
+               ridge [r].index = j;
+               ridge [r].key = keys + r * (G_d - 2);
+               for (l = 0, g = 0; l < G_d; l++)
+                  if (l != i && l != j)
+                     ridge [r].key [g++] = facet [v].vertex [l];
+               qsort (ridge [r].key, G_d - 2, sizeof (int), compare_ints);
+               r++;
+            }
+      }
+      qsort (ridge, ridges, sizeof (T_Ridge), compare_ridges);
+
+      /* if a ridge does not occur exactly twice, the horizon is pinched; this happens */
+      /* when p lies in the hyperplane of a facet between visible ones, which is then  */
+      /* added to the visible facets                                                   */
+      ok = TRUE;
+      extended = FALSE;
+      for (r = 0; r < ridges; r = l)
+      {  l = r + 1;
+         while (l < ridges && compare_ridges (ridge + r, ridge + l) == 0)
+            l++;
+         if (l - r != 2)
+         {  ok = FALSE;
+            for (; r < l; r++)
+            {  k = ridge [r].facet;
+               nb = facet [horizon [2 * k]].neighbour [horizon [2 * k + 1]];
+               if (!facet [nb].visible && fabs (height (nb, p)) <= INCIDENCE_EPSILON)
+               {  facet [nb].visible = TRUE;
+                  visible = append (visible, &visibles, &maxvisibles, nb);
+                  extended = TRUE;
+               }
+            }
+         }
+      }
+      if (!ok)
+      {  my_free (ridge, ridges * sizeof (T_Ridge));
+         free_int_vector (keys, ridges * (G_d - 2) + 1);
+      }
+   }
+
+   if (ok)
+   {  /* build the cone; the new facet keeps the neighbour across the horizon, whose   */
+      /* hyperplane it inherits if its points are too close to a common (G_d-2)-flat */
+      /* for its own to be reliable                                                   */
+      for (k = 0; k < horizons; k++)
+      {  v = horizon [2 * k];
+         i = horizon [2 * k + 1];
+         g = new_facet ();
+         nb = facet [v].neighbour [i];
+         for (j = 0; j < G_d; j++)
+            facet [g].vertex [j] = facet [v].vertex [j];
+         facet [g].vertex [i] = p;
+         facet [g].neighbour [i] = nb;
+         for (j = 0; j < G_d; j++)
+            if (facet [nb].neighbour [j] == v)
+               facet [nb].neighbour [j] = g;
+         compute_hyperplane (g);
+         if (facet [g].size == 0)
+         {  for (j = 0; j < G_d; j++)
+               facet [g].normal [j] = facet [nb].normal [j];
+            facet [g].offset = facet [nb].offset;
+         }
+      }
+      for (r = 0; r < ridges; r += 2)
+      {  facet [first + ridge [r].facet].neighbour [ridge [r].index]
+            = first + ridge [r+1].facet;
+         facet [first + ridge [r+1].facet].neighbour [ridge [r+1].index]
+            = first + ridge [r].facet;
+      }
+      my_free (ridge, ridges * sizeof (T_Ridge));
+      free_int_vector (keys, ridges * (G_d - 2) + 1);
+
+      /* distribute the points attached to the visible facets and remove these */
+      for (k = 0; k < visibles; k++)
+      {  v = visible [k];
+         for (j = 0; j < facet [v].outsides; j++)
+            if (facet [v].outside [j] != p)
+               attach (facet [v].outside [j], first);
+         remove_facet (v);
+      }
+   }
+
+   free_int_vector (visible, maxvisibles);
+   free_int_vector (horizon, maxhorizon);
+   return ok;
+}
+
+/****************************************************************************************/
+
+static int compare_first_coordinates (const void *p, const void *q)
+   /* compares the first coordinates of the points with the indices *p and *q */
+
+{  real x = point [*(const int *) p] [0], y = point [*(const int *) q] [0];
+
+   return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+/****************************************************************************************/
+
+static void find_duplicates (int n)
+   /* marks the points closer than INCIDENCE_EPSILON in each coordinate to a point with */
+   /* a smaller index as duplicates; they are found by sorting by the first coordinate */
+
+{  int i, j, k, *index;
+
+   index = create_int_vector (n);
+   for (i = 0; i < n; i++)
+   {  index [i] = i;
+      duplicate [i] = FALSE;
+   }
+   qsort (index, n, sizeof (int), compare_first_coordinates);
+   for (i = 0; i < n; i++)
+      for (k = i + 1; k < n && point [index [k]] [0] - point [index [i]] [0] < INCIDENCE_EPSILON;
+           k++)
+      {  j = 1;
+         while (j < G_d && fabs (point [index [k]] [j] - point [index [i]] [j]) < INCIDENCE_EPSILON)
+            j++;
+         if (j == G_d)
+            duplicate [index [i] > index [k] ? index [i] : index [k]] = TRUE;
+      }
+   free_int_vector (index, n);
+}
+
+/****************************************************************************************/
+
+static boolean quickhull (int n)
+   /* computes the simplices of the hull of the points; returns FALSE if the horizon of */
+   /* one of the added points is not a manifold                                         */
+
+{  int     f, i, step = 0;
+   boolean ok = TRUE;
+
+   for (i = 0; i < n; i++)
+      if (!duplicate [i])
+         attach (i, 0);
+   /* new facets are appended, so that a single pass treats all of them */
+   for (f = 0; f < facets && ok; f++)
+      if (facet [f].alive && facet [f].outsides > 0)
+         ok = add_point (facet [f].furthest, f, ++step);
+   return ok;
+}
+
+/****************************************************************************************/
+
+static int compare_sizes (const void *p, const void *q)
+   /* compares the facets with the indices *p and *q by decreasing size */
+
+{  real x = facet [*(const int *) p].size, y = facet [*(const int *) q].size;
+
+   return (x > y ? -1 : (x < y ? 1 : 0));
+}
+
+/****************************************************************************************/
+
+static int opposite (int f, int g)
+   /* returns the point of facet f opposite to the ridge it shares with facet g */
+
+{  int j = 0;
+
+   while (facet [f].neighbour [j] != g)
+      j++;
+   return facet [f].vertex [j];
+}
+
+/****************************************************************************************/
+
+static int merge_facets (real ***planes, boolean *extreme)
+   /* recomputes the simplices from the points and merges neighbouring ones if all     */
+   /* points of one of them lie in the hyperplane of the largest simplex of the group  */
+   /* containing the other one, which is the one determined most accurately; returns   */
+   /* the number of groups and their hyperplanes in the newly created matrix *planes.   */
+   /* Each group is started by a non-degenerate simplex. The points spanning the        */
+   /* simplices are marked in extreme.                                                  */
+
+{  int f, g, i, j, k, l, m = 0, *order, *component, *stack, *root;
+
+   order = create_int_vector (facets);
+   component = create_int_vector (facets);
+   stack = create_int_vector (facets);
+   root = create_int_vector (facets);
+
+   k = 0;
+   for (f = 0; f < facets; f++)
+   {  component [f] = -1;
+      if (facet [f].alive)
+      {  compute_hyperplane (f);
+         for (j = 0; j < G_d; j++)
+            extreme [facet [f].vertex [j]] = TRUE;
+         if (facet [f].size > 0)
+            order [k++] = f;
+      }
+   }
+   qsort (order, k, sizeof (int), compare_sizes);
+
+   for (i = 0; i < k; i++)
+   {  f = order [i];
+      if (component [f] < 0)
+      {  component [f] = m;
+         root [m] = f;
+         stack [0] = f;
+         l = 1;
+         while (l > 0)
+         {  g = stack [--l];
+            for (j = 0; j < G_d; j++)
+               if (component [facet [g].neighbour [j]] < 0
+                   && fabs (height (f, opposite (facet [g].neighbour [j], g)))
+                      <= INCIDENCE_EPSILON)
+               {  component [facet [g].neighbour [j]] = m;
+                  stack [l++] = facet [g].neighbour [j];
+               }
+         }
+         m++;
+      }
+   }
+
+   *planes = create_matrix (m, G_d + 1);
+   for (k = 0; k < m; k++)
+   {  for (j = 0; j < G_d; j++)
+         (*planes) [k] [j] = facet [root [k]].normal [j];
+      (*planes) [k] [G_d] = facet [root [k]].offset;
+   }
+
+   free_int_vector (root, facets);
+   free_int_vector (stack, facets);
+   free_int_vector (component, facets);
+   free_int_vector (order, facets);
+   return m;
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
+
+int convex_hull (real **points, int n, real ***planes, boolean *extreme)
+   /* computes the facets of the convex hull of the n points, which are returned in the */
+   /* newly created matrix *planes in the format of G_Hyperplanes with normals of       */
+   /* length one; their number is returned. extreme [i] is set if the i-th point spans  */
+   /* one of the simplices into which the facets are split or lies close to the         */
+   /* boundary, so that all vertices of the hull are marked. If the points are not      */
+   /* full-dimensional, -1 is returned and *planes is not set.                          */
+
+{  int i, f, m;
+
+   point = points;
+   candidate = extreme;
+   duplicate = (boolean *) my_malloc (n * sizeof (boolean));
+   centre = create_vector ();
+   Q = create_matrix (G_d, G_d);
+   maxfacets = 2 * (G_d + 1);
+   facet = (T_Facet *) my_malloc (maxfacets * sizeof (T_Facet));
+   facets = 0;
+   for (i = 0; i < n; i++)
+      extreme [i] = FALSE;
+   find_duplicates (n);
+
+   if (!initial_simplex (n))
+      m = -1;
+   else if (!quickhull (n))
+   {  fprintf (stderr, "\n***** ERROR: The convex hull could not be computed reliably in ");
+      fprintf (stderr, "'convex_hull'.\n");
+      exit (0);
+   }
+   else
+      m = merge_facets (planes, extreme);
+
+   for (f = 0; f < facets; f++)
+      if (facet [f].alive)
+         remove_facet (f);
+   my_free (facet, maxfacets * sizeof (T_Facet));
+   free_matrix (Q, G_d, G_d);
+   free_vector (centre);
+   my_free (duplicate, n * sizeof (boolean));
+
+   return m;
+}
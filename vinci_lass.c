@@ -39,7 +39,7 @@
 /******************/
 
 rational *A;
-rational *pivotrow;             /* copy of pivot row */
+rational *pivotrow = NULL;      /* copy of pivot row */
 T_LassInt *All_index;  /* All eliminated and superfluous indices (sorted) */
 T_LassInt *Pivot;      /* All substituted variables (sorted) */
 int **p2c;        /* pivot to constraints: which variable is fixed in which constraint;
@@ -50,6 +50,9 @@ rational  * planescopy;               /* needed in shift_P in the lasserre-code
 static T_Key   key, *keyfound;    /* key for storing the actually considered face and   */
                                   /* found key when a volume could be retrieved */
 static T_Tree  *tree_volumes;     /* tree for storing intermediate volumes */
+static int     lass_storage;      /* storage level, G_Storage or -1 for no storage */
+static int     *lass_weight = NULL;
+   /* orbit weights of the hyperplanes if symmetries are exploited on the top level */
 
 
 /***************/
@@ -127,6 +130,17 @@ static void rm_original_inElAll_index(T_LassInt baserow)
 {   del_original(baserow, All_index); }
 
 
+static int original_index(int red)
+/* returns the original index of the constraint with reduced index red, see
+   add_reduced_index; All_index is not changed */
+
+{ register int i;
+
+  for (i=0; red>=All_index[i]; i++) red++;
+  return red;
+}
+
+
 static void rm_constraint(rational* A, int *LastPlane_, int d, int rm_index)
 /* removes the constraints given in rm_index and adjusts *LastPlane */
 
@@ -179,14 +193,19 @@ static void shift_P(rational *A, int LastPlane_, int d)
 
 {   register rational  *p1, *p2, *p3, d1, d2, d3;
     register int col, i, j;
-    static int *pivot = NULL;
-                 /* contains the pivot row of each column */
+    static int *pivot = NULL, dimension = -1;
+                 /* contains the pivot row of each column; it is created again */
+                 /* when G_d changes */
 
     #ifdef STATISTICS
 	Stat_CountShifts ++;
     #endif
 
-    if (pivot == NULL) pivot = create_int_vector (G_d + 1);
+    if (dimension != G_d) {
+        if (pivot != NULL) free_int_vector (pivot, dimension + 1);
+        pivot = create_int_vector (G_d + 1);
+        dimension = G_d;
+    };
     
     p1=A;                         /* search pivot of first column */
     pivot[0]=0; 
@@ -494,12 +513,14 @@ static rational lass(rational *A, int LastPlane_, int d)
     boolean i_balance = FALSE;
     rational ma, mi, *volume, *realp1, *realp2;
     int Index_needed;         /* Boolean, if index operations are needed */
+    int Track_deleted;        /* Boolean, if the deleted planes must be known */
+    int weight = 1;           /* orbit weight of the constraint on the top level */
     T_LassInt * Del_index = NULL; /* contains the indices of the deleted planes */
 
     /* test if volume is already known and return it if so */
 
     dimdiff = G_d-d;
-    if ((G_Storage > (dimdiff-2)) && (dimdiff >= 2)) {
+    if ((lass_storage > (dimdiff-2)) && (dimdiff >= 2)) {
         tree_out (&tree_volumes, &i_balance, key, &volume, &keyfound, KEY_PLANES_VAR);
         if ((*volume)>=0)  {  /* this volume has already been computed */
 	    #ifdef STATISTICS
@@ -540,8 +561,9 @@ static rational lass(rational *A, int LastPlane_, int d)
 
     /* if d>1 apply the recursive scheme by fixing constraints. */
 
-    Index_needed = (G_Storage>(G_d-d-1));
-    if (Index_needed){
+    Index_needed = (lass_storage>(G_d-d-1));
+    Track_deleted = Index_needed || (lass_weight != NULL && d == G_d);
+    if (Track_deleted){
 	if (!(Del_index = (T_LassInt *) my_malloc ((LastPlane_ + 2) * sizeof (T_LassInt)))){
 	    fprintf (stderr, "\n***** ERROR/WARNING: Out of memory in 'lass'\n");
 	    exit(0);
@@ -549,12 +571,13 @@ static rational lass(rational *A, int LastPlane_, int d)
         Del_index[0]=G_m+2;   /* initialize: mark end */
     }
     ma=0;                                         /* used to sum up the summands */
-    if (norm_and_clean_constraints(A, &LastPlane_, d, Del_index, Index_needed)!=0)
+    if (norm_and_clean_constraints(A, &LastPlane_, d, Del_index, Track_deleted)!=0)
         goto label2;
 
-    /* if appropriate shift polytope */
+    /* if appropriate shift polytope; not on the top level if symmetries are used,
+       since the centre of symmetry must stay in the origin */
 
-    if (d>=LaShiftLevel) {
+    if (d>=LaShiftLevel && !(lass_weight != NULL && d == G_d)) {
 	realp1=A+d;
 	realp2=realp1+LastPlane_*(d+1);
 	j=0;
@@ -578,6 +601,10 @@ static rational lass(rational *A, int LastPlane_, int d)
 #endif
 	if (fabs(*(A+row*(d+1)+d))<EPSILON_LASS) 
             continue;                        /* skip this constraint if b_row == 0 */
+	if (lass_weight != NULL && d == G_d) {
+	    weight = lass_weight[original_index(row)];
+	    if (weight == 0) continue;       /* not the representative of its orbit */
+	}
 	if (Index_needed)
 	{  baserow=add_reduced_index(row, NULL, All_index);
            p2c[G_d-d][1] = baserow;
@@ -591,7 +618,7 @@ static rational lass(rational *A, int LastPlane_, int d)
 #endif
 	    if (fabs(pivotrow[i])>fabs(pivotrow[col])) col=i;
 	};
-	if (G_Storage>(G_d-d-1))
+	if (lass_storage>(G_d-d-1))
 	{  basecol=add_reduced_index(col, NULL, Pivot);
            p2c[G_d-d][0] = basecol;
 	   add_hypervar (G_m+1, basecol, &key);
@@ -619,13 +646,13 @@ static rational lass(rational *A, int LastPlane_, int d)
 		realp2++;
 	    };
 	};
-	ma+= *(A+row*(d+1)+d)/(d*fabs(*(A+row*(d+1)+col)))
+	ma+= weight * *(A+row*(d+1)+d)/(d*fabs(*(A+row*(d+1)+col)))
 	     *lass(redA, LastPlane_-1, d-1);
         if (Index_needed)
         {  rm_original_inElAll_index(baserow);
            delete_hypervar (baserow, G_d+1, &key);
         }
-	if (G_Storage>(G_d-d-1))
+	if (lass_storage>(G_d-d-1))
 	{  del_original(basecol, Pivot);
 	   delete_hypervar (G_m+1, basecol, &key);
 	}
@@ -636,7 +663,7 @@ static rational lass(rational *A, int LastPlane_, int d)
     };
     my_free (redA, LastPlane_* d * sizeof (rational));
     label2: 
-    if (Index_needed) {
+    if (Track_deleted) {
 	del_original_indices(Del_index, All_index);
         my_free (Del_index, (LastPlane_ + 2) * sizeof (T_LassInt));
     };
@@ -648,7 +675,7 @@ static rational lass(rational *A, int LastPlane_, int d)
 
 void volume_lasserre_file (rational *volume, char *planesfile)
 
-{  int i;
+{  int i, j;
 
    read_hyperplanes (planesfile);
    if (G_m > 254)
@@ -671,6 +698,16 @@ void volume_lasserre_file (rational *volume, char *planesfile)
    A=compact();
    planescopy=compact();
    tree_volumes = NULL;
+   lass_storage = G_Storage;
+
+   /* With symmetries, the centre of symmetry is shifted into the origin, so that the
+      summands for the facets in one orbit on the top level coincide. */
+   if (G_SymmetryFile != NULL && compute_symmetries (G_SymmetryFile, NULL) > 0)
+   {  lass_weight = orbit_weights ();
+      for (i=0; i<G_m; i++)
+         for (j=0; j<G_d; j++)
+            A[i*(G_d+1)+G_d] -= A[i*(G_d+1)+j] * symmetry_centre ()[j];
+   }
    create_key (&key, KEY_PLANES_VAR);
    key.hypervar.hyperplanes [0] = G_m + 1;
    key.hypervar.variables [0] = G_d + 1;
@@ -681,9 +718,53 @@ void volume_lasserre_file (rational *volume, char *planesfile)
 #endif
    *volume = lass (A, G_m-1, G_d);
 
+   if (lass_weight != NULL)
+   {  free_symmetries ();
+      lass_weight = NULL;
+   }
+   free_lasserre ();
+
 /*
    free_key (key, KEY_PLANES_VAR);
 */
 }
 
 /****************************************************************************************/
+
+rational volume_lasserre (rational *A, int m, int d)
+   /* returns the d-dimensional volume of the polytope given by the m inequalities in   */
+   /* A, stored row by row as d coefficients followed by the right hand side, with      */
+   /* d <= G_d and m <= G_m. A is destroyed. No intermediate volumes are stored, so     */
+   /* that the function may be called independently of 'volume_lasserre_file', e. g.   */
+   /* for the faces handed to Lasserre's method by the method 'hybrid'.                 */
+
+{  int      storage = lass_storage;
+   rational volume;
+
+   if (pivotrow == NULL)
+   {  pivotrow = (rational *) my_malloc ((G_d + 1) * sizeof (rational));
+      planescopy = (rational *) my_malloc (G_m * (G_d + 1) * sizeof (rational));
+   }
+
+   lass_storage = -1;
+   volume = lass (A, m - 1, d);
+   lass_storage = storage;
+
+   return volume;
+}
+
+/****************************************************************************************/
+
+void free_lasserre ()
+   /* frees the work space of Lasserre's method, which has been allocated for the      */
+   /* present values of G_d and G_m; the next polytope may be bigger.                  */
+
+{
+   if (pivotrow != NULL)
+   {  my_free (pivotrow, (G_d + 1) * sizeof (rational));
+      my_free (planescopy, G_m * (G_d + 1) * sizeof (rational));
+      pivotrow = NULL;
+   }
+}
+
+/****************************************************************************************/
@@ -93,6 +93,21 @@ void my_free (void *pointer, long int size)
 
 /****************************************************************************************/
 
+void account_memory (long int size_diff)
+   /* keeps track in the statistical variables of size_diff bytes which have been       */
+   /* allocated (or freed, if negative) without the above functions, e.g. by threads    */
+   /* which must not update the statistics concurrently                                 */
+
+{
+#ifdef STATISTICS
+   Stat_ActualMem += size_diff;
+   if (Stat_ActualMem > Stat_MaxMem)
+      Stat_MaxMem = Stat_ActualMem;
+#endif
+}
+
+/****************************************************************************************/
+
 T_Vertex *create_vertex ()
    /* create a new vertex */
 
@@ -109,11 +124,25 @@ T_Vertex *create_vertex ()
 
 /****************************************************************************************/
 
+T_Vertex *create_mapped_vertex (real *coords)
+   /* create a new vertex whose coordinates are stored in the binary file at coords */
+
+{
+   T_Vertex *v;
+
+   v = (T_Vertex *) my_malloc (sizeof (T_Vertex));
+   v -> coords = coords;
+   return v;
+}
+
+/****************************************************************************************/
+
 void free_vertex (T_Vertex *v)
    /* frees the memory space needed by the dynamic components of v and v itself */
 
 {  
-   my_free (v -> coords, G_d  * sizeof (real));
+   if (!in_binary_file (v -> coords))
+      my_free (v -> coords, G_d  * sizeof (real));
    my_free (v, sizeof (T_Vertex));
 }
   
@@ -142,7 +171,8 @@ void free_hyperplanes ()
 {  int i;
 
    for (i = 0; i < G_m; i++)
-      my_free (G_Hyperplanes [i], (G_d + 1) * sizeof (real));
+      if (!in_binary_file (G_Hyperplanes [i]))
+         my_free (G_Hyperplanes [i], (G_d + 1) * sizeof (real));
    my_free (G_Hyperplanes, G_m * sizeof (real *));
 }
 
@@ -296,15 +326,36 @@ void free_int_vector (int *v, int n)
 
 /****************************************************************************************/
 
+static long int row_length (int n)
+   /* returns the number of entries reserved for a row with n entries, so that the      */
+   /* next row starts at a multiple of MATRIX_ALIGN bytes */
+
+{  long int step = MATRIX_ALIGN / sizeof (rational);
+
+   if (step < 1)
+      step = 1;
+   return (n + step - 1) / step * step;
+}
+
+/****************************************************************************************/
+
 rational **create_matrix (int m, int n)
-   /* reserves memory space for an mXn matrix */
+   /* reserves memory space for an mXn matrix. The rows are stored in one block, each   */
+   /* starting at a multiple of MATRIX_ALIGN bytes, so that loops over the entries may  */
+   /* be vectorised; they may still be exchanged by exchanging the row pointers. The    */
+   /* address of the block is kept in the additional pointer A [m].                     */
    
 {  int     i;
-   rational **A;
+   rational **A, *first;
+   char     *block;
    
-   A = (rational **) my_malloc (m * sizeof (rational *));
+   A = (rational **) my_malloc ((m + 1) * sizeof (rational *));
+   block = (char *) my_malloc (m * row_length (n) * sizeof (rational) + MATRIX_ALIGN);
+   first = (rational *) (block + (MATRIX_ALIGN - (unsigned long) block % MATRIX_ALIGN)
+                                 % MATRIX_ALIGN);
    for (i = 0; i < m; i++)
-      A [i] = (rational *) my_malloc (n * sizeof (rational));
+      A [i] = first + i * row_length (n);
+   A [m] = (rational *) block;
    
    return A;
 }
@@ -312,34 +363,133 @@ rational **create_matrix (int m, int n)
 /****************************************************************************************/
 
 void redim_matrix (rational ***A, int m_alt, int m_neu, int n)
-   /* resizes the matrix A to m_neu rows */
+   /* resizes the matrix A to m_neu rows, keeping the contents of the first m_alt ones */
    
-{  int i;
+{  int      i;
+   rational **B = create_matrix (m_neu, n);
 
-   (*A) = (rational **) my_realloc (*A, m_neu * sizeof (rational *), 
-                                         (m_neu - m_alt) * sizeof (rational *));
-   if (*A == NULL)
-   {  fprintf (stderr, "\n***** ERROR: Out of memory in 'redim_matrix.'");
-      exit (0);
+   for (i = 0; i < m_alt && i < m_neu; i++)
+      memcpy (B [i], (*A) [i], n * sizeof (rational));
+   free_matrix (*A, m_alt, n);
+   *A = B;
+}
+
+/****************************************************************************************/
+
+void free_matrix (rational **A, int m, int n)
+   /* frees the memory space needed by the matrix A */
+
+{
+   my_free (A [m], m * row_length (n) * sizeof (rational) + MATRIX_ALIGN);
+   my_free (A, (m + 1) * sizeof (rational *));
+}
+
+/****************************************************************************************/
+/*                                       arenas                                         */
+/****************************************************************************************/
+
+#define ARENA_ALIGN sizeof (union {double d; void *p; long int l;})
+   /* all pieces handed out by an arena are aligned to this size */
+#define ARENA_HEADER \
+   (((long int) sizeof (T_ArenaBlock) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN)
+   /* size of the block header, rounded up so that the usable bytes are aligned */
+
+/****************************************************************************************/
+
+static T_ArenaBlock *create_arena_block (long int size, T_ArenaBlock *next)
+   /* reserves a block with size usable bytes and chains it in front of next */
+
+{  T_ArenaBlock *block;
+
+   block = (T_ArenaBlock *) my_malloc (ARENA_HEADER + size);
+   block -> next = next;
+   block -> size = size;
+   block -> used = 0;
+
+   return block;
+}
+
+/****************************************************************************************/
+
+static void free_arena_blocks (T_ArenaBlock *block)
+   /* frees the specified block and all blocks chained behind it */
+
+{  T_ArenaBlock *next;
+
+   while (block != NULL)
+   {  next = block -> next;
+      my_free (block, ARENA_HEADER + block -> size);
+      block = next;
    }
+}
 
-   for (i = m_alt; i < m_neu; i++)
-   {
-      (*A) [i] = (rational *) my_malloc (n * sizeof (rational));
+/****************************************************************************************/
+
+T_Arena *create_arenas ()
+   /* reserves memory space for one arena per recursion level, i. e. for each dimension */
+   /* d from 0 to G_d; G_d must be set correctly                                        */
+
+{  int     d;
+   T_Arena *arena;
+
+   arena = (T_Arena *) my_malloc ((G_d + 1) * sizeof (T_Arena));
+   for (d = 0; d <= G_d; d++)
+   {  arena [d].block = create_arena_block (ARENASIZE, NULL);
+      arena [d].total = ARENASIZE;
    }
 
+   return arena;
 }
 
 /****************************************************************************************/
 
-void free_matrix (rational **A, int m, int n)
-   /* frees the memory space needed by the matrix A */
+void free_arenas (T_Arena *arena)
+   /* frees the memory space used by the arenas and everything allocated from them */
 
-{  int i;
+{  int d;
 
-   for (i = 0; i < m; i++)
-      my_free (A [i], n * sizeof (rational));
-   my_free (A,  m * sizeof (rational *));
+   for (d = 0; d <= G_d; d++)
+      free_arena_blocks (arena [d].block);
+   my_free (arena, (G_d + 1) * sizeof (T_Arena));
+}
+
+/****************************************************************************************/
+
+void *arena_malloc (T_Arena *arena, long int size)
+   /* returns a piece of size bytes from the arena; it must not be freed or resized,    */
+   /* but stays valid until the arena is cleared                                        */
+
+{  T_ArenaBlock *block = arena -> block;
+   void         *pointer;
+
+   size = (size + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+
+   if (block -> used + size > block -> size)
+   {  /* chain a new block which is at least as big as all the previous ones together */
+      block = create_arena_block (size > arena -> total ? size : arena -> total, block);
+      arena -> block = block;
+      arena -> total += block -> size;
+   }
+
+   pointer = (char *) block + ARENA_HEADER + block -> used;
+   block -> used += size;
+
+   return pointer;
+}
+
+/****************************************************************************************/
+
+void clear_arena (T_Arena *arena)
+   /* releases everything allocated from the arena at once; if several blocks have     */
+   /* been needed, they are merged into one so that this does not happen again          */
+
+{
+   if (arena -> block -> next == NULL)
+      arena -> block -> used = 0;
+   else
+   {  free_arena_blocks (arena -> block);
+      arena -> block = create_arena_block (arena -> total, NULL);
+   }
 }
 
 /****************************************************************************************/
@@ -376,11 +526,16 @@ void free_key (T_Key key, int key_choice)
 
 #ifdef STATISTICS
 
+static int stat_dimension;
+   /* the number of entries of Stat_CountStored and Stat_CountRetrieved */
+
 void init_statistics ()
-   /* initializes the statistical variables */
+   /* initializes the statistical variables; those of a previous polytope are freed */
    
 {  int i;
 
+   if (Stat_CountStored != NULL)
+      free_statistics ();
    Stat_Count = 0;
    Stat_Smallest = 1e199;
    Stat_Biggest = -1e199;
@@ -389,10 +544,12 @@ void init_statistics ()
       Stat_CountNeg [i] = 0;
    }
 
-   Stat_CountStored = (unsigned int *) my_malloc ((G_d - 1) * sizeof (unsigned int));
-   Stat_CountRetrieved = (unsigned int *) my_malloc ((G_d - 1) * sizeof (unsigned int));
+   /* the facets of dimension G_d - 1 are stored in the session mode */
+   Stat_CountStored = (unsigned int *) my_malloc (G_d * sizeof (unsigned int));
+   Stat_CountRetrieved = (unsigned int *) my_malloc (G_d * sizeof (unsigned int));
    
-   for (i = 0; i < G_d - 1; i++)
+   stat_dimension = G_d;
+   for (i = 0; i < G_d; i++)
       Stat_CountStored [i] = Stat_CountRetrieved [i] = 0;
 
    Stat_CountShifts = 0;
@@ -453,10 +610,13 @@ void update_statistics (rational volume)
 /****************************************************************************************/
 
 void free_statistics ()
+   /* frees the arrays created by "init_statistics" */
 
 {
-   free (Stat_CountStored);
-   free (Stat_CountRetrieved);
+   my_free (Stat_CountStored, stat_dimension * sizeof (unsigned int));
+   my_free (Stat_CountRetrieved, stat_dimension * sizeof (unsigned int));
+   Stat_CountStored = NULL;
+   Stat_CountRetrieved = NULL;
 }
 
 #endif
@@ -537,6 +697,7 @@ void tree_out (T_Tree **ppr , boolean *pi_balance, T_Key key, rational **volume,
       (*ppr) -> tree_l = NULL;
       (*ppr) -> tree_r = NULL;
       (*ppr) -> tree_b = 0;
+      (*ppr) -> tree_u = TRUE;
       /* copy the key into the new node */
       create_key (&((*ppr) -> key), key_choice);
       switch (key_choice)
@@ -656,6 +817,7 @@ void tree_out (T_Tree **ppr , boolean *pi_balance, T_Key key, rational **volume,
    else
    {
       *pi_balance = FALSE;
+      (*ppr) -> tree_u = TRUE;
       *volume = &((*ppr) -> vol);
       *keyfound = &((*ppr) -> key);
    }
@@ -663,6 +825,23 @@ void tree_out (T_Tree **ppr , boolean *pi_balance, T_Key key, rational **volume,
 
 /****************************************************************************************/
 
+void free_tree (T_Tree *tree, int key_choice)
+   /* frees all nodes of the tree together with their keys */
+
+{
+   if (tree == NULL)
+      return;
+   free_tree (tree -> tree_l, key_choice);
+   free_tree (tree -> tree_r, key_choice);
+   if (key_choice == KEY_VERTICES)
+      free_set (tree -> key.vertices.set);
+   else
+      free_key (tree -> key, key_choice);
+   my_free (tree, sizeof (T_Tree));
+}
+
+/****************************************************************************************/
+
 void add_hypervar (T_LassInt hyperplane, T_LassInt variable, T_Key *key)
    /* adds the specified hyperplane and variable index to the variable "key" maintain-  */
    /* ing the ascending orders; if one index is G_m+1 resp. G_d+1 it is omitted.        */
@@ -0,0 +1,427 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                  vinci_precision.c                                   */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* Authors: Benno Bueeler (bueeler@ifor.math.ethz.ch)                                   */
+/*          and                                                                         */
+/*          Andreas Enge (enge@ifor.math.ethz.ch)                                       */
+/*          Institute for Operations Research                                           */
+/*	    Swiss Federal Institute of Technology Zurich                                */
+/*	    Switzerland                                                                 */
+/*                                                                                      */
+/* Last Changes: October 19, 2026                                                       */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* extended precision for the summands of Lawrence's formula                           */
+/*                                                                                      */
+/****************************************************************************************/
+
+#include "vinci.h"
+
+/* A number in double-double precision is represented as the unevaluated sum hi + lo of */
+/* two doubles with |lo| <= ulp (hi) / 2, which gives about 106 bits of mantissa. The   */
+/* error free transformations of Knuth and Dekker are used, which rely on the rounding  */
+/* to nearest of each operation; they must not be contracted to fused multiply-adds,    */
+/* which the ISO modes of gcc guarantee. With __float128, the summands are computed in  */
+/* quadruple precision and rounded to double-double afterwards.                         */
+
+typedef struct
+        {real hi, lo;
+        } T_DD;
+
+/****************************************************************************************/
+
+static T_DD quick_two_sum (real a, real b)
+   /* returns a + b exactly, provided that |a| >= |b| */
+
+{  T_DD s;
+
+   s.hi = a + b;
+   s.lo = b - (s.hi - a);
+   return s;
+}
+
+/****************************************************************************************/
+
+static T_DD two_sum (real a, real b)
+   /* returns a + b exactly */
+
+{  T_DD s;
+   real v;
+
+   s.hi = a + b;
+   v = s.hi - a;
+   s.lo = (a - (s.hi - v)) + (b - v);
+   return s;
+}
+
+/****************************************************************************************/
+
+static T_DD two_prod (real a, real b)
+   /* returns a * b exactly by Dekker's splitting into halves of 26 bits */
+
+{  T_DD p;
+   real t, a_hi, a_lo, b_hi, b_lo;
+
+   t = 134217729.0 * a;
+   a_hi = t - (t - a);
+   a_lo = a - a_hi;
+   t = 134217729.0 * b;
+   b_hi = t - (t - b);
+   b_lo = b - b_hi;
+   p.hi = a * b;
+   p.lo = ((a_hi * b_hi - p.hi) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+   return p;
+}
+
+/****************************************************************************************/
+
+static T_DD dd_add (T_DD a, T_DD b)
+
+{  T_DD s, t;
+
+   s = two_sum (a.hi, b.hi);
+   t = two_sum (a.lo, b.lo);
+   s.lo += t.hi;
+   s = quick_two_sum (s.hi, s.lo);
+   s.lo += t.lo;
+   return quick_two_sum (s.hi, s.lo);
+}
+
+/****************************************************************************************/
+
+static T_DD dd_neg (T_DD a)
+
+{
+   a.hi = - a.hi;
+   a.lo = - a.lo;
+   return a;
+}
+
+/****************************************************************************************/
+
+static T_DD dd_mul (T_DD a, T_DD b)
+
+{  T_DD p;
+
+   p = two_prod (a.hi, b.hi);
+   p.lo += a.hi * b.lo + a.lo * b.hi;
+   return quick_two_sum (p.hi, p.lo);
+}
+
+/****************************************************************************************/
+
+static T_DD dd_div (T_DD a, T_DD b)
+   /* long division with two correction steps */
+
+{  T_DD q, r;
+   real q1, q2, q3;
+
+   q1 = a.hi / b.hi;
+   q.hi = q1;
+   q.lo = 0;
+   r = dd_add (a, dd_neg (dd_mul (q, b)));
+   q2 = r.hi / b.hi;
+   q.hi = q2;
+   r = dd_add (r, dd_neg (dd_mul (q, b)));
+   q3 = r.hi / b.hi;
+   q = quick_two_sum (q1, q2);
+   q.lo += q3;
+   return quick_two_sum (q.hi, q.lo);
+}
+
+/****************************************************************************************/
+
+static T_DD dd_real (real a)
+
+{  T_DD s;
+
+   s.hi = a;
+   s.lo = 0;
+   return s;
+}
+
+/****************************************************************************************/
+
+static void dd_summands (real **normal, real *x, real *c, real c0, real *hi, real *lo,
+   boolean *failed, T_DD *M)
+   /* computes the summands as described for "extended_summands" in double-double      */
+   /* precision, using the matrix M with G_d rows of G_d + G_Objectives entries, which  */
+   /* is followed by the G_d coordinates of the vertex and the G_d pivot rows           */
+
+{  int  i, j, k, l, pivot, columns = G_d + G_Objectives, *row;
+   T_DD det, factor, t, fv, Nv, *X;
+
+   X = M + G_d * columns;
+   row = (int *) (X + G_d);
+
+   /* the normals (transposed) and the objective functions */
+   for (i = 0; i < G_d; i++)
+   {  for (j = 0; j < G_d; j++)
+         M [i * columns + j] = dd_real (normal [j] [i]);
+      for (k = 0; k < G_Objectives; k++)
+         M [i * columns + G_d + k] = dd_real (c [k * G_d + i]);
+   }
+
+   /* Gaussian elimination with partial pivoting */
+   det = dd_real (1);
+   for (j = 0; j < G_d; j++)
+   {  pivot = j;
+      for (i = j + 1; i < G_d; i++)
+         if (fabs (M [i * columns + j].hi) > fabs (M [pivot * columns + j].hi))
+            pivot = i;
+      if (M [pivot * columns + j].hi == 0)
+      {  for (k = 0; k < G_Objectives; k++)
+            failed [k] = TRUE;
+         return;
+      }
+      row [j] = pivot;
+      if (pivot != j)
+         /* the multipliers stored in the previous columns are exchanged as well */
+         for (l = 0; l < columns; l++)
+         {  t = M [j * columns + l];
+            M [j * columns + l] = M [pivot * columns + l];
+            M [pivot * columns + l] = t;
+         }
+      det = dd_mul (det, M [j * columns + j]);
+      for (i = j + 1; i < G_d; i++)
+      {  factor = dd_div (M [i * columns + j], M [j * columns + j]);
+         for (l = j + 1; l < columns; l++)
+            M [i * columns + l] = dd_add (M [i * columns + l],
+                                          dd_neg (dd_mul (factor, M [j * columns + l])));
+         M [i * columns + j] = factor;
+      }
+   }
+   if (det.hi < 0)
+      det = dd_neg (det);
+
+   if (x != NULL)
+      for (i = 0; i < G_d; i++)
+         X [i] = dd_real (x [i]);
+   else
+   {  /* The vertex solves A x = b, where the transposed A = P^T L U has just been     */
+      /* factorised; so U^T z = b, L^T y = z and x = P^T y.                             */
+      for (i = 0; i < G_d; i++)
+      {  t = dd_real (normal [i] [G_d]);
+         for (l = 0; l < i; l++)
+            t = dd_add (t, dd_neg (dd_mul (M [l * columns + i], X [l])));
+         X [i] = dd_div (t, M [i * columns + i]);
+      }
+      for (i = G_d - 1; i >= 0; i--)
+         for (l = i + 1; l < G_d; l++)
+            X [i] = dd_add (X [i], dd_neg (dd_mul (M [l * columns + i], X [l])));
+      for (j = G_d - 1; j >= 0; j--)
+      {  t = X [j];
+         X [j] = X [row [j]];
+         X [row [j]] = t;
+      }
+   }
+
+   for (k = 0; k < G_Objectives; k++)
+   {  /* back substitution, the solution overwriting the column of c_k */
+      for (i = G_d - 1; i >= 0; i--)
+      {  t = M [i * columns + G_d + k];
+         for (l = i + 1; l < G_d; l++)
+            t = dd_add (t, dd_neg (dd_mul (M [i * columns + l], M [l * columns + G_d + k])));
+         M [i * columns + G_d + k] = dd_div (t, M [i * columns + i]);
+      }
+
+      fv = dd_real (c0);
+      for (i = 0; i < G_d; i++)
+         fv = dd_add (fv, dd_mul (dd_real (c [k * G_d + i]), X [i]));
+      Nv = dd_div (dd_real (1), det);
+      for (i = 0; i < G_d && !failed [k]; i++)
+         if (fabs (M [i * columns + G_d + k].hi) < EPSILON)
+            failed [k] = TRUE;
+         else
+            Nv = dd_mul (dd_div (Nv, M [i * columns + G_d + k]), fv);
+      if (!failed [k])
+      {  t.hi = hi [k];
+         t.lo = lo [k];
+         t = dd_add (t, Nv);
+         hi [k] = t.hi;
+         lo [k] = t.lo;
+      }
+   }
+}
+
+/****************************************************************************************/
+
+#ifdef __SIZEOF_FLOAT128__
+
+static void quad_summands (real **normal, real *x, real *c, real c0, real *hi, real *lo,
+   boolean *failed, __float128 *M)
+   /* computes the summands as "dd_summands" in quadruple precision */
+
+{  int        i, j, k, l, pivot, columns = G_d + G_Objectives, *row;
+   __float128 det, factor, t, fv, Nv, *X;
+   T_DD       sum, term;
+
+   X = M + G_d * columns;
+   row = (int *) (X + G_d);
+
+   for (i = 0; i < G_d; i++)
+   {  for (j = 0; j < G_d; j++)
+         M [i * columns + j] = normal [j] [i];
+      for (k = 0; k < G_Objectives; k++)
+         M [i * columns + G_d + k] = c [k * G_d + i];
+   }
+
+   det = 1;
+   for (j = 0; j < G_d; j++)
+   {  pivot = j;
+      for (i = j + 1; i < G_d; i++)
+         if ((M [i * columns + j] < 0 ? - M [i * columns + j] : M [i * columns + j])
+             > (M [pivot * columns + j] < 0 ? - M [pivot * columns + j] : M [pivot * columns + j]))
+            pivot = i;
+      if (M [pivot * columns + j] == 0)
+      {  for (k = 0; k < G_Objectives; k++)
+            failed [k] = TRUE;
+         return;
+      }
+      row [j] = pivot;
+      if (pivot != j)
+         /* the multipliers stored in the previous columns are exchanged as well */
+         for (l = 0; l < columns; l++)
+         {  t = M [j * columns + l];
+            M [j * columns + l] = M [pivot * columns + l];
+            M [pivot * columns + l] = t;
+         }
+      det *= M [j * columns + j];
+      for (i = j + 1; i < G_d; i++)
+      {  factor = M [i * columns + j] / M [j * columns + j];
+         for (l = j + 1; l < columns; l++)
+            M [i * columns + l] -= factor * M [j * columns + l];
+         M [i * columns + j] = factor;
+      }
+   }
+   if (det < 0)
+      det = - det;
+
+   if (x != NULL)
+      for (i = 0; i < G_d; i++)
+         X [i] = x [i];
+   else
+   {  for (i = 0; i < G_d; i++)
+      {  t = normal [i] [G_d];
+         for (l = 0; l < i; l++)
+            t -= M [l * columns + i] * X [l];
+         X [i] = t / M [i * columns + i];
+      }
+      for (i = G_d - 1; i >= 0; i--)
+         for (l = i + 1; l < G_d; l++)
+            X [i] -= M [l * columns + i] * X [l];
+      for (j = G_d - 1; j >= 0; j--)
+      {  t = X [j];
+         X [j] = X [row [j]];
+         X [row [j]] = t;
+      }
+   }
+
+   for (k = 0; k < G_Objectives; k++)
+   {  for (i = G_d - 1; i >= 0; i--)
+      {  t = M [i * columns + G_d + k];
+         for (l = i + 1; l < G_d; l++)
+            t -= M [i * columns + l] * M [l * columns + G_d + k];
+         M [i * columns + G_d + k] = t / M [i * columns + i];
+      }
+
+      fv = c0;
+      for (i = 0; i < G_d; i++)
+         fv += c [k * G_d + i] * X [i];
+      Nv = 1 / det;
+      for (i = 0; i < G_d && !failed [k]; i++)
+         if (fabs ((real) M [i * columns + G_d + k]) < EPSILON)
+            failed [k] = TRUE;
+         else
+            Nv = Nv / M [i * columns + G_d + k] * fv;
+      if (!failed [k])
+      {  sum.hi = hi [k];
+         sum.lo = lo [k];
+         term = quick_two_sum ((real) Nv, (real) (Nv - (real) Nv));
+         sum = dd_add (sum, term);
+         hi [k] = sum.hi;
+         lo [k] = sum.lo;
+      }
+   }
+}
+
+#endif
+
+/****************************************************************************************/
+/****************************************************************************************/
+
+boolean quad_available ()
+   /* tells whether the compiler provides __float128 */
+
+{
+#ifdef __SIZEOF_FLOAT128__
+   return TRUE;
+#else
+   return FALSE;
+#endif
+}
+
+/****************************************************************************************/
+
+void *create_extended_work ()
+   /* returns the work space needed by "extended_summands" */
+
+{
+   return my_malloc ((G_d * (G_d + G_Objectives + 1)) * 2 * sizeof (real)
+                     + G_d * sizeof (int));
+}
+
+/****************************************************************************************/
+
+void free_extended_work (void *work)
+
+{
+   my_free (work, (G_d * (G_d + G_Objectives + 1)) * 2 * sizeof (real)
+                  + G_d * sizeof (int));
+}
+
+/****************************************************************************************/
+
+void extended_summands (real **normal, real *x, real *c, real c0, real *hi, real *lo,
+   boolean *failed, void *work)
+   /* adds the summands of Lawrence's formula at the vertex x, which is the             */
+   /* intersection of the G_d hyperplanes normal [0] to normal [G_d-1] in the format of */
+   /* G_Hyperplanes and is computed from them if x is NULL, for the objective           */
+   /* functions c (with G_d consecutive entries each,                                   */
+   /* and c0 as constant term) to hi [k] + lo [k], computed in the precision            */
+   /* G_Precision. If the objective function k is orthogonal to an edge, failed [k] is  */
+   /* set. The work space must have been created by "create_extended_work"; it is the   */
+   /* only memory written besides the results, so that several threads may call the     */
+   /* function at the same time.                                                        */
+
+{
+#ifdef __SIZEOF_FLOAT128__
+   if (G_Precision == PRECISION_QUAD)
+      quad_summands (normal, x, c, c0, hi, lo, failed, (__float128 *) work);
+   else
+#endif
+      dd_summands (normal, x, c, c0, hi, lo, failed, (T_DD *) work);
+}
+
+/****************************************************************************************/
+
+void extended_add (real *hi, real *lo, real b_hi, real b_lo)
+   /* adds b_hi + b_lo to hi + lo in double-double precision */
+
+{  T_DD a, b;
+
+   a.hi = *hi;
+   a.lo = *lo;
+   b.hi = b_hi;
+   b.lo = b_lo;
+   a = dd_add (a, b);
+   *hi = a.hi;
+   *lo = a.lo;
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
@@ -0,0 +1,190 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                    vinci_sample.c                                    */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* Authors: Benno Bueeler (bueeler@ifor.math.ethz.ch)                                   */
+/*          and                                                                         */
+/*          Andreas Enge (enge@ifor.math.ethz.ch)                                       */
+/*          Institute for Operations Research                                           */
+/*	    Swiss Federal Institute of Technology Zurich                                */
+/*	    Switzerland                                                                 */
+/*                                                                                      */
+/* Last Changes: October 19, 2026                                                       */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* uniform sampling of points from a triangulated polytope                              */
+/*                                                                                      */
+/****************************************************************************************/
+
+#include "vinci.h"
+
+/* A point is drawn by choosing a simplex with probability proportional to its volume  */
+/* with the alias method of Walker and Vose, and then a point of the simplex with       */
+/* barycentric coordinates following the uniform Dirichlet distribution, obtained by    */
+/* normalising d+1 independent exponentially distributed values. The random numbers     */
+/* are taken from Marsaglia's xorshift128 generator, so that the samples are the same   */
+/* on all platforms for a given seed.                                                   */
+
+static unsigned long state [4];
+   /* state of the random number generator; only the lower 32 bits are used */
+
+/****************************************************************************************/
+
+static void seed_random (int seed)
+   /* initialises the state of the random number generator from the seed */
+
+{  int           i;
+   unsigned long x = (unsigned long) seed & 0xffffffffUL;
+
+   for (i = 0; i < 4; i++)
+   {  /* one step of a linear congruential generator for each word */
+      x = (69069UL * x + 362437UL) & 0xffffffffUL;
+      state [i] = x;
+   }
+   if ((state [0] | state [1] | state [2] | state [3]) == 0)
+      state [0] = 1;
+}
+
+/****************************************************************************************/
+
+static unsigned long random_word ()
+   /* returns 32 random bits */
+
+{  unsigned long t = (state [0] ^ (state [0] << 11)) & 0xffffffffUL;
+
+   state [0] = state [1];
+   state [1] = state [2];
+   state [2] = state [3];
+   state [3] = (state [3] ^ (state [3] >> 19) ^ t ^ (t >> 8)) & 0xffffffffUL;
+   return state [3];
+}
+
+/****************************************************************************************/
+
+static real random_real ()
+   /* returns a random number in [0, 1) with 53 random bits */
+
+{  unsigned long a = random_word () >> 5, b = random_word () >> 6;
+
+   return (a * 67108864.0 + b) / 9007199254740992.0;
+}
+
+/****************************************************************************************/
+
+static void alias_table (rational *volume, int n, real *prob, int *alias)
+   /* builds the alias table for choosing i with probability proportional to volume [i] */
+   /* by Vose's method: a random index i is kept with probability prob [i] and replaced */
+   /* by alias [i] otherwise.                                                           */
+
+{  int      i, s, l, small = 0, large = 0, *small_list, *large_list;
+   rational total = 0;
+
+   small_list = create_int_vector (n);
+   large_list = create_int_vector (n);
+
+   for (i = 0; i < n; i++)
+      total += volume [i];
+   for (i = 0; i < n; i++)
+   {  prob [i] = volume [i] * n / total;
+      alias [i] = i;
+      if (prob [i] < 1)
+         small_list [small++] = i;
+      else
+         large_list [large++] = i;
+   }
+
+   while (small > 0 && large > 0)
+   {  s = small_list [--small];
+      l = large_list [large - 1];
+      alias [s] = l;
+      prob [l] -= 1 - prob [s];
+      if (prob [l] < 1)
+      {  large--;
+         small_list [small++] = l;
+      }
+   }
+   /* the remaining entries differ from 1 only by rounding errors */
+   while (large > 0)
+      prob [large_list [--large]] = 1;
+   while (small > 0)
+      prob [small_list [--small]] = 1;
+
+   free_int_vector (small_list, n);
+   free_int_vector (large_list, n);
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
+
+void sample_points (char *filename, long int count, int *simplex, rational *volume, int n)
+   /* writes count points drawn uniformly from the union of the n simplices to the      */
+   /* file; simplex contains the numbers of the G_d + 1 vertices of each simplex, which */
+   /* index G_Vertices, and volume their volumes. The points are written as double in   */
+   /* batches of SAMPLE_BATCH after the header "VINCISP1", the dimension as int and the */
+   /* number of points as long int. The random seed is G_RandomSeed.                    */
+
+{  FILE     *f;
+   real     *prob, *batch, *lambda, sum;
+   int      *alias, *s, i, j, k, filled = 0;
+   long int l;
+
+   if (! (f = fopen (filename, "wb")))
+   {  fprintf (stderr, "\n***** ERROR: Could not open file '%s' in 'sample_points'.\n",
+               filename);
+      exit (0);
+   }
+   fwrite ("VINCISP1", 1, 8, f);
+   fwrite (&G_d, sizeof (int), 1, f);
+   fwrite (&count, sizeof (long int), 1, f);
+
+   prob = (real *) my_malloc (n * sizeof (real));
+   alias = create_int_vector (n);
+   alias_table (volume, n, prob, alias);
+
+   seed_random (G_RandomSeed);
+   batch = (real *) my_malloc (SAMPLE_BATCH * G_d * sizeof (real));
+   lambda = (real *) my_malloc ((G_d + 1) * sizeof (real));
+
+   for (l = 0; l < count; l++)
+   {  /* choose a simplex */
+      k = (int) (random_real () * n);
+      if (random_real () >= prob [k])
+         k = alias [k];
+      s = simplex + k * (G_d + 1);
+
+      /* choose barycentric coordinates */
+      sum = 0;
+      for (i = 0; i <= G_d; i++)
+      {  lambda [i] = - log (1 - random_real ());
+         sum += lambda [i];
+      }
+
+      for (j = 0; j < G_d; j++)
+      {  batch [filled * G_d + j] = 0;
+         for (i = 0; i <= G_d; i++)
+            batch [filled * G_d + j] += lambda [i] * G_Vertices.loe [s [i]] -> coords [j];
+         batch [filled * G_d + j] /= sum;
+      }
+
+      if (++filled == SAMPLE_BATCH || l == count - 1)
+      {  if (fwrite (batch, G_d * sizeof (real), filled, f) != filled)
+         {  fprintf (stderr, "\n***** ERROR: Could not write to file '%s' in 'sample_points'.\n",
+                     filename);
+            exit (0);
+         }
+         filled = 0;
+      }
+   }
+   fclose (f);
+
+   my_free (prob, n * sizeof (real));
+   free_int_vector (alias, n);
+   my_free (batch, SAMPLE_BATCH * G_d * sizeof (real));
+   my_free (lambda, (G_d + 1) * sizeof (real));
+}
+
+/****************************************************************************************/
+/****************************************************************************************/
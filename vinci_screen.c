@@ -148,6 +148,7 @@ void print_statistics (FILE *f, int method)
                   Stat_CountPos [STAT_BIGGEST_EXP - STAT_SMALLEST_EXP + 2]);
       break;
    case HOT:
+   case HYBRID:
    case RLASS:
       fprintf(f, "\n\nStatistics of storing intermediate results:");
       fprintf (f, "\n\ndimension   volumes stored   volumes retrieved\n\n");
@@ -163,7 +164,7 @@ void print_statistics (FILE *f, int method)
       fprintf(f, "\n  all");
       fprintf(f, "%17i", sum_stored);
       fprintf(f, "%18i", sum_retrieved);
-      if (method == RLASS)
+      if (method == RLASS || method == HYBRID)
          fprintf(f, "\n\n%i shifts performed.", Stat_CountShifts);
       break;
    }
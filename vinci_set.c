@@ -26,14 +26,16 @@
 /****************************************************************************************/
 
 static void redimloe (T_VertexSet *s)
-   /* adds some space to loe */
+   /* adds some space to loe; the array is at least doubled so that a set filled       */
+   /* element by element is copied only a logarithmic number of times                  */
 
-{
-   s -> maxel += ARRAYSIZESTEP;
+{  int step = (s -> maxel + 1 > ARRAYSIZESTEP ? s -> maxel + 1 : ARRAYSIZESTEP);
+
+   s -> maxel += step;
 
    s -> loe = (T_Vertex **)
               my_realloc (s -> loe, (s -> maxel + 1) * sizeof (T_Vertex *),
-                          ARRAYSIZESTEP * sizeof (T_Vertex *));
+                          step * sizeof (T_Vertex *));
 }
 
 /****************************************************************************************/
@@ -124,6 +126,21 @@ T_VertexSet duplicate_set (T_VertexSet s)
       
 /****************************************************************************************/
 
+T_VertexSet duplicate_set_in_arena (T_Arena *arena, T_VertexSet s)
+   /* creates a new set with the same elements as s, taking the memory from the arena;  */
+   /* the new set must neither be freed nor be enlarged.                                */
+
+{  T_VertexSet newset;
+
+   newset.maxel = s.lastel;
+   newset.lastel = s.lastel;
+   newset.loe = (T_Vertex **) arena_malloc (arena, (s.lastel + 1) * sizeof (T_Vertex *));
+   memcpy (newset.loe, s.loe, (s.lastel + 1) * sizeof (T_Vertex *));
+   return newset;
+}
+
+/****************************************************************************************/
+
 void copy_set (T_VertexSet s1, T_VertexSet *s2)
    /* copies the set s1 elementwise to s2 */
    
@@ -135,52 +152,292 @@ void copy_set (T_VertexSet s1, T_VertexSet *s2)
 
 /****************************************************************************************/
 
-void renumber_vertices ()
-   /* The vertices in the global variable G_Vertices are renumbered in the following    */
-   /* way: If the i-th vertex is contained in k hyperplanes, it gets the number - k so  */
-   /* that highly degenerate vertices get lower numbers. Then the set is reordered and  */
-   /* numbered from 0 on. If it is not void, the global variable G_Incidence is         */
-   /* changed accordingly.                                                              */
+static int order_strategy;
+   /* vertex ordering strategy used by "compare_vertices" */
+static unsigned int *hilbert_key;
+   /* for each vertex G_d words of HILBERT_BITS bits containing its Hilbert index, the */
+   /* most significant bits first */
+static int *planesize;
+   /* number of vertices in each hyperplane */
+
+/****************************************************************************************/
 
+static int compare_vertices (const void *p, const void *q)
+   /* compares the vertices at the positions *p and *q of G_Vertices following          */
+   /* order_strategy; ties are broken by the positions, so that the order is determined */
+   /* uniquely. For ORDER_DEGENERACY the field "no" must contain minus the number of     */
+   /* hyperplanes through each vertex.                                                  */
 
-{
-   int i, j, k;
-   T_Vertex *tmp_vertex;
-   boolean *tmp_incidence;
+{  int      i = *(const int *) p, j = *(const int *) q, k;
+   T_Vertex *v = G_Vertices.loe [i], *w = G_Vertices.loe [j];
+
+   switch (order_strategy)
+   {
+   case ORDER_LEX:
+      for (k = 0; k < G_d; k++)
+         if (v -> coords [k] != w -> coords [k])
+            return (v -> coords [k] < w -> coords [k] ? -1 : 1);
+      break;
+   case ORDER_HILBERT:
+      for (k = 0; k < G_d; k++)
+         if (hilbert_key [i * G_d + k] != hilbert_key [j * G_d + k])
+            return (hilbert_key [i * G_d + k] < hilbert_key [j * G_d + k] ? -1 : 1);
+      break;
+   default:
+      if (v -> no != w -> no)
+         return (v -> no < w -> no ? -1 : 1);
+   }
+
+   return (i < j ? -1 : (i > j));
+}
+
+/****************************************************************************************/
+
+static int compare_planes (const void *p, const void *q)
+   /* compares the hyperplanes *p and *q such that those containing more vertices come  */
+   /* first; ties are broken by the numbers of the hyperplanes                          */
+
+{  int i = *(const int *) p, j = *(const int *) q;
+
+   if (planesize [i] != planesize [j])
+      return (planesize [i] > planesize [j] ? -1 : 1);
+   return (i < j ? -1 : (i > j));
+}
+
+/****************************************************************************************/
+
+static void compute_hilbert_keys ()
+   /* The coordinates of the vertices are mapped to integers of HILBERT_BITS bits, which */
+   /* are transformed into the "transposed" Hilbert index with Skilling's algorithm     */
+   /* (Programming the Hilbert curve, AIP Conference Proceedings 707, 2004). Its bits   */
+   /* are then interleaved into hilbert_key.                                            */
+
+{  unsigned int *x = (unsigned int *) my_malloc (G_d * sizeof (unsigned int));
+   unsigned int m = 1U << (HILBERT_BITS - 1), p, q, t;
+   rational     *low = create_vector (), *high = create_vector ();
+   int          i, j, k, b, bit;
+
+   for (j = 0; j < G_d; j++)
+   {  low [j] = high [j] = G_Vertices.loe [0] -> coords [j];
+      for (i = 1; i < G_n; i++)
+         if (G_Vertices.loe [i] -> coords [j] < low [j])
+            low [j] = G_Vertices.loe [i] -> coords [j];
+         else if (G_Vertices.loe [i] -> coords [j] > high [j])
+            high [j] = G_Vertices.loe [i] -> coords [j];
+   }
 
    for (i = 0; i < G_n; i++)
-      G_Vertices.loe [i] -> no = 0;
+   {  for (j = 0; j < G_d; j++)
+         if (high [j] - low [j] > EPSILON)
+            x [j] = (unsigned int) ((G_Vertices.loe [i] -> coords [j] - low [j])
+                                    / (high [j] - low [j]) * (2 * (rational) m - 1));
+         else
+            x [j] = 0;
+
+      /* inverse undo */
+      for (q = m; q > 1; q >>= 1)
+      {  p = q - 1;
+         for (j = 0; j < G_d; j++)
+            if (x [j] & q)
+               x [0] ^= p;
+            else
+            {  t = (x [0] ^ x [j]) & p;
+               x [0] ^= t;
+               x [j] ^= t;
+            }
+      }
+      /* Gray encode */
+      for (j = 1; j < G_d; j++)
+         x [j] ^= x [j-1];
+      t = 0;
+      for (q = m; q > 1; q >>= 1)
+         if (x [G_d - 1] & q)
+            t ^= q - 1;
+      for (j = 0; j < G_d; j++)
+         x [j] ^= t;
+
+      /* interleave the bits, the most significant ones of all coordinates first */
+      for (k = 0; k < G_d; k++)
+         hilbert_key [i * G_d + k] = 0;
+      bit = 0;
+      for (b = HILBERT_BITS - 1; b >= 0; b--)
+         for (j = 0; j < G_d; j++, bit++)
+            if ((x [j] >> b) & 1)
+               hilbert_key [i * G_d + bit / HILBERT_BITS]
+                  |= 1U << (HILBERT_BITS - 1 - bit % HILBERT_BITS);
+   }
+
+   my_free (x, G_d * sizeof (unsigned int));
+   free_vector (low);
+   free_vector (high);
+}
+
+/****************************************************************************************/
+
+static long int probe_order (int *order)
+   /* counts the faces examined on the first two recursion levels of "tri" and          */
+   /* "tri_ortho" if the vertices are ordered as given by the positions in order: the   */
+   /* facets not containing the first vertex and, for each of them, the hyperplanes not  */
+   /* containing its first vertex but at least G_d - 1 of its vertices. Faces reached   */
+   /* through several hyperplanes are counted repeatedly.                               */
+
+{  int      *rank = create_int_vector (G_n), *facet = create_int_vector (G_n);
+   int      i, k, l, size, first, common;
+   long int count = 0;
 
    for (i = 0; i < G_n; i++)
+      rank [order [i]] = i;
+
+   for (k = 0; k < G_m; k++)
+      if (!G_Incidence [order [0]] [k] && planesize [k] >= G_d)
+      {  count++;
+         size = 0;
+         first = -1;
+         for (i = 0; i < G_n; i++)
+            if (G_Incidence [i] [k])
+            {  facet [size++] = i;
+               if (first == -1 || rank [i] < rank [first])
+                  first = i;
+            }
+         for (l = 0; l < G_m; l++)
+            if (l != k && !G_Incidence [first] [l])
+            {  common = 0;
+               for (i = 0; i < size; i++)
+                  if (G_Incidence [facet [i]] [l])
+                     common++;
+               if (common >= G_d - 1)
+                  count++;
+            }
+      }
+
+   free_int_vector (rank, G_n);
+   free_int_vector (facet, G_n);
+   return count;
+}
+
+/****************************************************************************************/
+
+static void order_hyperplanes ()
+   /* sorts the hyperplanes by decreasing number of vertices, so that big facets are    */
+   /* considered first; G_Hyperplanes, if it is set, and the columns of G_Incidence are */
+   /* permuted accordingly.                                                             */
+
+{  int     *order = create_int_vector (G_m);
+   real    **planes;
+   boolean *row = (boolean *) my_malloc (G_m * sizeof (boolean));
+   int     i, k;
+
+   for (k = 0; k < G_m; k++)
+      order [k] = k;
+   qsort (order, G_m, sizeof (int), compare_planes);
+
+   if (G_Hyperplanes != NULL)
+   {  planes = (real **) my_malloc (G_m * sizeof (real *));
+      for (k = 0; k < G_m; k++)
+         planes [k] = G_Hyperplanes [order [k]];
+      memcpy (G_Hyperplanes, planes, G_m * sizeof (real *));
+      my_free (planes, G_m * sizeof (real *));
+   }
+   for (i = 0; i < G_n; i++)
+   {  for (k = 0; k < G_m; k++)
+         row [k] = G_Incidence [i] [order [k]];
+      memcpy (G_Incidence [i], row, G_m * sizeof (boolean));
+   }
+
+   free_int_vector (order, G_m);
+   my_free (row, G_m * sizeof (boolean));
+}
+
+/****************************************************************************************/
+
+void renumber_vertices ()
+   /* The vertices in the global variable G_Vertices are reordered following the        */
+   /* strategy in G_Order and numbered from 0 on; the global variable G_Incidence, which */
+   /* must be set, is changed accordingly. The strategies are:                          */
+   /* ORDER_DEGENERACY: vertices contained in many hyperplanes come first;              */
+   /* ORDER_LEX: lexicographic order of the coordinates;                                */
+   /* ORDER_HILBERT: order along a Hilbert curve through the bounding box;              */
+   /* ORDER_FACETS: as ORDER_DEGENERACY, and additionally the hyperplanes are sorted by */
+   /* decreasing number of vertices;                                                    */
+   /* ORDER_AUTO: the first three strategies are tried with "probe_order", and the one  */
+   /* leading to the fewest faces on the first recursion levels is chosen.              */
+
+{
+   static char *names [] = {"", "degeneracy", "lex", "hilbert"};
+   int         i, j, strategy, best = 0;
+   int         *order = create_int_vector (G_n);
+   long int    count, best_count = -1;
+   T_Vertex    **vertices;
+   boolean     **incidence;
+
+   planesize = create_int_vector (G_m);
+   for (j = 0; j < G_m; j++)
+      planesize [j] = 0;
+   for (i = 0; i < G_n; i++)
+   {  G_Vertices.loe [i] -> no = 0;
       for (j = 0; j < G_m; j++)
          if (G_Incidence [i][j])
-            G_Vertices.loe [i] -> no --;
+         {  G_Vertices.loe [i] -> no --;
+            planesize [j] ++;
+         }
+   }
 
-   /* sort the set of vertices */
-   for (i = 0; i < G_n - 1; i++)
-   {
-      /* look for the smallest vertex with index j >= i and swap with i */
-      j = i;
-      for (k = i + 1; k < G_n; k++)
-         if (G_Vertices.loe [k] -> no < G_Vertices.loe [j] -> no)
-            j = k;
-      if (i != j)
-      {
-         tmp_vertex = G_Vertices.loe [i];
-         G_Vertices.loe [i] = G_Vertices.loe [j];
-         G_Vertices.loe [j] = tmp_vertex;
-         if (G_Incidence != NULL)
-         {
-            tmp_incidence = G_Incidence [i];
-            G_Incidence [i] = G_Incidence [j];
-            G_Incidence [j] = tmp_incidence;
+   hilbert_key = NULL;
+   if (G_Order == ORDER_HILBERT || G_Order == ORDER_AUTO)
+   {  hilbert_key = (unsigned int *) my_malloc (G_n * G_d * sizeof (unsigned int));
+      compute_hilbert_keys ();
+   }
+
+   if (G_Order == ORDER_AUTO)
+   {  for (strategy = ORDER_DEGENERACY; strategy <= ORDER_HILBERT; strategy++)
+      {  order_strategy = strategy;
+         for (i = 0; i < G_n; i++)
+            order [i] = i;
+         qsort (order, G_n, sizeof (int), compare_vertices);
+         count = probe_order (order);
+         printf ("Ordering '%s' leads to %li faces on the first two levels.\n",
+                 names [strategy], count);
+         if (best_count == -1 || count < best_count)
+         {  best = strategy;
+            best_count = count;
          }
       }
+      order_strategy = best;
+      printf ("Ordering '%s' chosen.\n", names [best]);
    }
+   else if (G_Order == ORDER_LEX || G_Order == ORDER_HILBERT)
+      order_strategy = G_Order;
+   else
+      order_strategy = ORDER_DEGENERACY;
+
+   for (i = 0; i < G_n; i++)
+      order [i] = i;
+   qsort (order, G_n, sizeof (int), compare_vertices);
+
+   vertices = (T_Vertex **) my_malloc (G_n * sizeof (T_Vertex *));
+   incidence = (boolean **) my_malloc (G_n * sizeof (boolean *));
+   for (i = 0; i < G_n; i++)
+   {  vertices [i] = G_Vertices.loe [order [i]];
+      incidence [i] = G_Incidence [order [i]];
+   }
+   memcpy (G_Vertices.loe, vertices, G_n * sizeof (T_Vertex *));
+   memcpy (G_Incidence, incidence, G_n * sizeof (boolean *));
+   my_free (vertices, G_n * sizeof (T_Vertex *));
+   my_free (incidence, G_n * sizeof (boolean *));
 
    for (i = 0; i < G_n; i++)
       G_Vertices.loe [i] -> no = i;
 
+   if (G_Order == ORDER_FACETS)
+   {  order_hyperplanes ();
+      printf ("Hyperplanes reordered.\n");
+   }
+
+   if (hilbert_key != NULL)
+      my_free (hilbert_key, G_n * G_d * sizeof (unsigned int));
+   free_int_vector (order, G_n);
+   free_int_vector (planesize, G_m);
+
    printf ("Vertices reordered.\n");
 }
 
@@ -190,7 +447,8 @@ rational normalise_vertices ()
    /* The vertices are expected in the global variable G_Vertices. In each dimension    */
    /* they are multiplied by a factor so that the entries are between -1 and 1. The     */
    /* return value is the product over the scaling factors in all dimensions; it is the */
-   /* scaling factor for the volume. G_d must be known!                                 */
+   /* scaling factor for the volume. G_d must be known! If G_Hyperplanes has been set,  */
+   /* the hyperplanes are transformed accordingly.                                      */
    
 {
    rational *scaling = create_vector ();
@@ -212,6 +470,9 @@ rational normalise_vertices ()
    {  scaling_volume *= scaling [j];
       for (i = 0; i <= G_Vertices.lastel; i++)
          G_Vertices.loe [i] -> coords [j] /= scaling [j];
+      if (G_Hyperplanes != NULL)
+         for (i = 0; i < G_m; i++)
+            G_Hyperplanes [i] [j] *= scaling [j];
    }
    my_free(scaling, sizeof(rational));
    return scaling_volume;
@@ -398,6 +659,21 @@ void add_superelement (T_VertexSuperset **S, T_VertexSet s)
    L -> next = *S;
    *S = L;
 }
+
+/****************************************************************************************/
+
+void add_superelement_in_arena (T_Arena *arena, T_VertexSuperset **S, T_VertexSet s)
+   /* adds the element s at the beginning to the set S, taking the memory for the new   */
+   /* node from the arena. S is released together with the arena and must not be       */
+   /* passed to free_superset.                                                          */
+
+{  T_VertexSuperset *L;
+
+   L = (T_VertexSuperset *) arena_malloc (arena, sizeof (T_VertexSuperset));
+   L -> content = s;
+   L -> next = *S;
+   *S = L;
+}
    
 /****************************************************************************************/
 /****************************************************************************************/
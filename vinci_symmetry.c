@@ -0,0 +1,473 @@
+/****************************************************************************************/
+/*                                                                                      */
+/*                                  vinci_symmetry.c                                    */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* Authors: Benno Bueeler (bueeler@ifor.math.ethz.ch)                                   */
+/*          and                                                                         */
+/*          Andreas Enge (enge@ifor.math.ethz.ch)                                       */
+/*          Institute for Operations Research                                           */
+/*	    Swiss Federal Institute of Technology Zurich                                */
+/*	    Switzerland                                                                 */
+/*                                                                                      */
+/* Last Changes: October 19, 2026                                                       */
+/*                                                                                      */
+/****************************************************************************************/
+/*                                                                                      */
+/* detection of symmetries of the polytope and their use for the volume computation     */
+/*                                                                                      */
+/****************************************************************************************/
+
+#include "vinci.h"
+
+/* A symmetry is a signed permutation of the coordinates around a centre c, i. e. the   */
+/* map x -> c + Q (x - c) with (Q y) [j] = sign [j] * y [perm [j]]. It is an isometry,  */
+/* so that all face volumes are invariant. The group is given by generators; their     */
+/* actions on the hyperplanes and on the vertices are stored as permutations.           */
+
+static int      generators = 0;
+static int      **plane_image, **vertex_image;
+   /* images of the hyperplanes and of the vertex numbers under the generators */
+static rational *centre;
+static rational **rows;
+   /* hyperplanes normalised to unit length, with right hand sides relative to centre */
+static rational **coords;
+   /* coordinates of the vertices, indexed by their numbers */
+static int      *sorted_rows, *sorted_coords;
+   /* row and vertex numbers in the order of "compare_points" */
+static int      *plane_class;
+   /* the representative among the hyperplanes equal to the given one */
+static int      *weight;
+   /* see "orbit_weights" */
+static int      *face_work, *face_image;
+   /* work space for "canonical_face" */
+
+static rational **points;
+   /* points compared by "compare_points" */
+static rational *probe;
+   /* point with the number -1 for "compare_points" */
+static int      point_dim;
+   /* number of entries of the points compared by "compare_points" */
+
+/****************************************************************************************/
+
+static int compare_points (const void *p, const void *q)
+   /* compares the points with numbers *p and *q lexicographically, considering entries */
+   /* equal when they differ by less than SYMMETRY_EPSILON                              */
+
+{  int      j, i1 = *(const int *) p, i2 = *(const int *) q;
+   rational *x = (i1 == -1 ? probe : points [i1]), *y = (i2 == -1 ? probe : points [i2]);
+
+   for (j = 0; j < point_dim; j++)
+      if (x [j] < y [j] - SYMMETRY_EPSILON)
+         return -1;
+      else if (x [j] > y [j] + SYMMETRY_EPSILON)
+         return 1;
+   return 0;
+}
+
+/****************************************************************************************/
+
+static void sort_points (rational **set, int size, int dim, int *sorted)
+   /* sorts the numbers of the points in set into sorted */
+
+{  int i;
+
+   points = set;
+   point_dim = dim;
+   for (i = 0; i < size; i++)
+      sorted [i] = i;
+   qsort (sorted, size, sizeof (int), compare_points);
+}
+
+/****************************************************************************************/
+
+static int find_point (rational **set, int size, int dim, int *sorted, rational *x)
+   /* returns the number of a point in set equal to x, where sorted is as returned by   */
+   /* "sort_points", or -1 if there is none                                             */
+
+{  int *found, key = -1;
+
+   points = set;
+   point_dim = dim;
+   probe = x;
+   found = (int *) bsearch (&key, sorted, size, sizeof (int), compare_points);
+   return (found == NULL ? -1 : *found);
+}
+
+/****************************************************************************************/
+
+static int compare_ints (const void *p, const void *q)
+
+{
+   return (*(const int *) p - *(const int *) q);
+}
+
+/****************************************************************************************/
+
+static void least_squares_centre ()
+   /* computes as centre the point minimising the sum of the squared residuals of the   */
+   /* normalised inequalities. It is fixed by every symmetry since these permute the     */
+   /* inequalities, and unique since the normals of a polytope span the space.          */
+
+{  rational **N = create_matrix (G_d, G_d + 1), norm, factor, tmp;
+   int      i, j, k, l, pivot;
+
+   for (j = 0; j < G_d; j++)
+      for (l = 0; l <= G_d; l++)
+         N [j] [l] = 0;
+   for (k = 0; k < G_m; k++)
+   {  norm = 0;
+      for (j = 0; j < G_d; j++)
+         norm += G_Hyperplanes [k] [j] * G_Hyperplanes [k] [j];
+      if (norm < EPSILON)
+         continue;
+      for (j = 0; j < G_d; j++)
+         for (l = 0; l <= G_d; l++)
+            N [j] [l] += G_Hyperplanes [k] [j] * G_Hyperplanes [k] [l] / norm;
+   }
+
+   /* Gaussian elimination with partial pivoting on the normal equations */
+   for (j = 0; j < G_d; j++)
+   {  pivot = j;
+      for (i = j + 1; i < G_d; i++)
+         if (fabs (N [i] [j]) > fabs (N [pivot] [j]))
+            pivot = i;
+      for (l = 0; l <= G_d; l++)
+      {  tmp = N [j] [l];
+         N [j] [l] = N [pivot] [l];
+         N [pivot] [l] = tmp;
+      }
+      for (i = j + 1; i < G_d; i++)
+      {  factor = N [i] [j] / N [j] [j];
+         for (l = j; l <= G_d; l++)
+            N [i] [l] -= factor * N [j] [l];
+      }
+   }
+   for (j = G_d - 1; j >= 0; j--)
+   {  centre [j] = N [j] [G_d];
+      for (l = j + 1; l < G_d; l++)
+         centre [j] -= N [j] [l] * centre [l];
+      centre [j] /= N [j] [j];
+   }
+
+   free_matrix (N, G_d, G_d + 1);
+}
+
+/****************************************************************************************/
+
+static boolean add_generator (int *p, int *s)
+   /* checks whether the signed permutation given by p and s maps the polytope to       */
+   /* itself and if so, adds it to the generators. The vertices are considered only if  */
+   /* they are known, i. e. if G_n > 0.                                                 */
+
+{  int      i, j, k, *planes, *vertices = NULL;
+   rational *x = (rational *) my_malloc ((G_d + 1) * sizeof (rational));
+   boolean  ok = TRUE;
+
+   /* a y <= beta becomes (Q a) z <= beta for z = Q y */
+   planes = create_int_vector (G_m);
+   for (k = 0; k < G_m && ok; k++)
+   {  for (j = 0; j < G_d; j++)
+         x [j] = s [j] * rows [k] [p [j]];
+      x [G_d] = rows [k] [G_d];
+      planes [k] = find_point (rows, G_m, G_d + 1, sorted_rows, x);
+      if (planes [k] == -1)
+         ok = FALSE;
+      else
+         planes [k] = plane_class [planes [k]];
+   }
+
+   if (ok && G_n > 0)
+   {  vertices = create_int_vector (G_n);
+      for (i = 0; i < G_n && ok; i++)
+      {  for (j = 0; j < G_d; j++)
+            x [j] = centre [j] + s [j] * (coords [i] [p [j]] - centre [p [j]]);
+         vertices [i] = find_point (coords, G_n, G_d, sorted_coords, x);
+         ok = (vertices [i] != -1);
+      }
+   }
+
+   if (ok)
+   {  plane_image [generators] = planes;
+      vertex_image [generators] = vertices;
+      generators++;
+   }
+   else
+   {  free_int_vector (planes, G_m);
+      if (vertices != NULL)
+         free_int_vector (vertices, G_n);
+   }
+
+   my_free (x, (G_d + 1) * sizeof (rational));
+   return ok;
+}
+
+/****************************************************************************************/
+
+static void read_symmetries (char *filename, int *p, int *s)
+   /* reads signed permutations of the coordinates from the file; each one consists of  */
+   /* G_d non-zero integers, the j-th being +-(i+1) if the j-th coordinate of the image */
+   /* is +- the i-th coordinate of the original point (relative to the centre)          */
+
+{  FILE    *f;
+   int     j, entry, count = 0, *used = create_int_vector (G_d);
+   boolean ok = TRUE;
+
+   if (!(f = fopen (filename, "r")))
+   {  free_int_vector (used, G_d);
+      return;
+   }
+
+   while (fscanf (f, "%i", &entry) == 1)
+   {  for (j = 0; j < G_d; j++)
+         used [j] = 0;
+      for (j = 0; j < G_d && ok; j++)
+      {  if (j > 0 && fscanf (f, "%i", &entry) != 1)
+            ok = FALSE;
+         else if (entry == 0 || abs (entry) > G_d || used [abs (entry) - 1])
+            ok = FALSE;
+         else
+         {  p [j] = abs (entry) - 1;
+            s [j] = (entry > 0 ? 1 : -1);
+            used [p [j]] = 1;
+         }
+      }
+      if (!ok)
+      {  fprintf (stderr, "\n***** ERROR: The file '%s' does not consist of signed permutations",
+                  filename);
+         fprintf (stderr, "\nof the %i coordinates.\n", G_d);
+         exit (0);
+      }
+      count++;
+      if (generators == SYMMETRY_GENERATORS || !add_generator (p, s))
+         printf ("Symmetry %i of '%s' is not a symmetry of the polytope and is ignored.\n",
+                 count, filename);
+   }
+
+   fclose (f);
+   free_int_vector (used, G_d);
+}
+
+/****************************************************************************************/
+
+static int find_root (int *parent, int k)
+
+{
+   while (parent [k] != k)
+      k = parent [k] = parent [parent [k]];
+   return k;
+}
+
+/****************************************************************************************/
+
+int compute_symmetries (char *filename, rational *fixed)
+   /* looks for symmetries among the sign changes and transpositions of coordinates and */
+   /* the cyclic shift of all coordinates, and reads further ones from the file if it   */
+   /* exists. fixed is a point fixed by all symmetries, e. g. the centroid of the       */
+   /* vertices; if it is NULL, the least squares centre of the hyperplanes is used. The */
+   /* vertices are used if G_n > 0. Returns the number of generators found; the orbits  */
+   /* of the hyperplanes are then available through "orbit_weights".                  */
+
+{  int      i, j, k, *p = create_int_vector (G_d), *s = create_int_vector (G_d);
+   int      *parent, orbits = 0;
+   rational norm;
+
+   generators = 0;
+   plane_image = (int **) my_malloc (SYMMETRY_GENERATORS * sizeof (int *));
+   vertex_image = (int **) my_malloc (SYMMETRY_GENERATORS * sizeof (int *));
+   centre = create_vector ();
+   rows = create_matrix (G_m, G_d + 1);
+   sorted_rows = create_int_vector (G_m);
+   plane_class = create_int_vector (G_m);
+   weight = create_int_vector (G_m);
+
+   if (fixed != NULL)
+      for (j = 0; j < G_d; j++)
+         centre [j] = fixed [j];
+   else
+      least_squares_centre ();
+
+   for (k = 0; k < G_m; k++)
+   {  norm = 0;
+      for (j = 0; j < G_d; j++)
+         norm += G_Hyperplanes [k] [j] * G_Hyperplanes [k] [j];
+      norm = sqrt (norm);
+      rows [k] [G_d] = G_Hyperplanes [k] [G_d];
+      for (j = 0; j < G_d; j++)
+      {  rows [k] [j] = G_Hyperplanes [k] [j] / norm;
+         rows [k] [G_d] -= G_Hyperplanes [k] [j] * centre [j];
+      }
+      rows [k] [G_d] /= norm;
+   }
+   sort_points (rows, G_m, G_d + 1, sorted_rows);
+   for (k = 0; k < G_m; k = i)
+   {  /* the run of hyperplanes equal to the k-th in sorted order is represented by the */
+      /* one with the smallest number */
+      j = sorted_rows [k];
+      for (i = k + 1; i < G_m && compare_points (&sorted_rows [k], &sorted_rows [i]) == 0; i++)
+         if (sorted_rows [i] < j)
+            j = sorted_rows [i];
+      for (i = k; i < G_m && compare_points (&sorted_rows [k], &sorted_rows [i]) == 0; i++)
+         plane_class [sorted_rows [i]] = j;
+   }
+
+   if (G_n > 0)
+   {  coords = (rational **) my_malloc (G_n * sizeof (rational *));
+      for (i = 0; i < G_n; i++)
+         coords [G_Vertices.loe [i] -> no] = G_Vertices.loe [i] -> coords;
+      sorted_coords = create_int_vector (G_n);
+      sort_points (coords, G_n, G_d, sorted_coords);
+   }
+
+   /* candidates */
+   for (j = 0; j < G_d; j++)
+   {  p [j] = j;
+      s [j] = 1;
+   }
+   for (i = 0; i < G_d && generators < SYMMETRY_GENERATORS; i++)
+   {  s [i] = -1;
+      add_generator (p, s);
+      s [i] = 1;
+      for (k = i + 1; k < G_d && generators < SYMMETRY_GENERATORS; k++)
+      {  p [i] = k;
+         p [k] = i;
+         add_generator (p, s);
+         p [i] = i;
+         p [k] = k;
+      }
+   }
+   if (G_d > 2 && generators < SYMMETRY_GENERATORS)
+   {  for (j = 0; j < G_d; j++)
+         p [j] = (j + 1) % G_d;
+      add_generator (p, s);
+   }
+   if (filename != NULL)
+      read_symmetries (filename, p, s);
+
+   /* orbits of the classes of equal hyperplanes */
+   parent = create_int_vector (G_m);
+   for (k = 0; k < G_m; k++)
+      parent [k] = k;
+   for (i = 0; i < generators; i++)
+      for (k = 0; k < G_m; k++)
+         parent [find_root (parent, plane_class [k])] = find_root (parent, plane_image [i] [k]);
+   for (k = 0; k < G_m; k++)
+      weight [k] = 0;
+   for (k = 0; k < G_m; k++)
+      if (plane_class [k] == k)
+         weight [find_root (parent, k)] ++;
+   for (k = 0; k < G_m; k++)
+      if (find_root (parent, plane_class [k]) != plane_class [k])
+         weight [k] = 0;
+      else if (plane_class [k] != k)
+         weight [k] = weight [plane_class [k]];
+      else
+         orbits++;
+   free_int_vector (parent, G_m);
+
+   printf ("%i generators of the symmetry group found; %i orbits of hyperplanes.\n",
+           generators, orbits);
+
+   face_work = create_int_vector (G_n > 0 ? G_n : 1);
+   face_image = create_int_vector (G_n > 0 ? G_n : 1);
+   free_int_vector (p, G_d);
+   free_int_vector (s, G_d);
+   return generators;
+}
+
+/****************************************************************************************/
+
+int * orbit_weights ()
+   /* returns for each hyperplane the size of its orbit, counted without repetitions of  */
+   /* equal hyperplanes, if it is equal to the representative of its orbit, and 0       */
+   /* otherwise. Summing a function invariant under the symmetries, multiplied by the   */
+   /* weights, over all different hyperplanes of some class thus gives its sum over all */
+   /* different hyperplanes.                                                            */
+
+{
+   return weight;
+}
+
+/****************************************************************************************/
+
+int plane_representative (int k)
+   /* returns the smallest number of a hyperplane equal to hyperplane k */
+
+{
+   return plane_class [k];
+}
+
+/****************************************************************************************/
+
+rational * symmetry_centre ()
+   /* returns the point fixed by all symmetries */
+
+{
+   return centre;
+}
+
+/****************************************************************************************/
+
+void canonical_face (T_VertexSet face, T_VertexSet *canon)
+   /* stores in canon the image of face under some symmetry that is minimal with respect */
+   /* to the lexicographic order of the vertex numbers among the images obtained by     */
+   /* greedily applying generators as long as this decreases the image. Faces in the    */
+   /* same orbit often, though not always, obtain the same canonical face.              */
+
+{  int     i, g, n = face.lastel + 1, *tmp;
+   boolean improved = TRUE;
+
+   for (i = 0; i < n; i++)
+      face_work [i] = face.loe [i] -> no;
+
+   while (improved)
+   {  improved = FALSE;
+      for (g = 0; g < generators; g++)
+      {  for (i = 0; i < n; i++)
+            face_image [i] = vertex_image [g] [face_work [i]];
+         qsort (face_image, n, sizeof (int), compare_ints);
+         for (i = 0; i < n && face_image [i] == face_work [i]; i++);
+         if (i < n && face_image [i] < face_work [i])
+         {  tmp = face_work;
+            face_work = face_image;
+            face_image = tmp;
+            improved = TRUE;
+         }
+      }
+   }
+
+   clear_set (canon);
+   for (i = 0; i < n; i++)
+      add_element (canon, G_Vertices.loe [face_work [i]]);
+}
+
+/****************************************************************************************/
+
+void free_symmetries ()
+
+{  int i;
+
+   for (i = 0; i < generators; i++)
+   {  free_int_vector (plane_image [i], G_m);
+      if (vertex_image [i] != NULL)
+         free_int_vector (vertex_image [i], G_n);
+   }
+   my_free (plane_image, SYMMETRY_GENERATORS * sizeof (int *));
+   my_free (vertex_image, SYMMETRY_GENERATORS * sizeof (int *));
+   free_vector (centre);
+   free_matrix (rows, G_m, G_d + 1);
+   free_int_vector (sorted_rows, G_m);
+   free_int_vector (plane_class, G_m);
+   free_int_vector (weight, G_m);
+   if (G_n > 0)
+   {  my_free (coords, G_n * sizeof (rational *));
+      free_int_vector (sorted_coords, G_n);
+   }
+   free_int_vector (face_work, G_n > 0 ? G_n : 1);
+   free_int_vector (face_image, G_n > 0 ? G_n : 1);
+   generators = 0;
+}
+
+/****************************************************************************************/
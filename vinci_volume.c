@@ -20,6 +20,7 @@
 /****************************************************************************************/
 
 #include "vinci.h"
+#include <float.h>
 
 /* global variables for C&H-triangulation and orthonormalisation */
 
@@ -29,9 +30,365 @@ static rational ***ortho_basis;
    /* orthonormal basis considered at each recursion level */
 static T_VertexSet S;
    /* simplex constructed so far (C&H) */
+static T_Arena *arena;
+   /* arena for the transient data of each recursion level */
 
 static T_Key   key;               /* key for storing the actually considered face */
 static T_Tree  *tree_volumes;     /* tree for storing intermediate volumes */
+static boolean cache = FALSE;     /* whether the tree is bounded, see 'vinci_cache' */
+
+/* global variables for the direct evaluation of small faces */
+
+static rational **local_X;
+   /* coordinates of the vertices of a face in its own affine hull, indexed by their   */
+   /* positions in the face */
+static rational *local_x;
+   /* all coordinates of a vertex after applying the Householder vectors */
+static rational *angle;
+   /* angles of the vertices of a polygon, indexed by their positions */
+static int *order;
+   /* positions of the vertices of a polygon, to be sorted cyclically */
+
+/* global variables for the exploitation of symmetries */
+
+static boolean symmetric = FALSE;
+   /* whether symmetries have been found */
+
+/* global variables for dumping face volumes */
+
+static FILE     *dump_file = NULL;
+   /* file to which the face volumes are written, or NULL */
+static T_Tree   *dump_tree;
+   /* all faces visited so far, with their volumes or -1 if these are yet unknown */
+static T_Key    dump_key;
+static int      *dump_id;
+   /* the numbers of the vertices in the input file, indexed by their current numbers */
+static int      *dump_record;
+   /* work space for one record */
+static long int dump_count;
+   /* number of records written */
+
+/* global variables for writing the triangulation of 'rch' */
+
+static FILE     *tri_file = NULL;
+   /* file to which the simplices are written, or NULL */
+static int      *tri_id;
+   /* the numbers of the vertices in the input file, indexed by their current numbers */
+static char     *tri_buffer;
+   /* records not yet written, at most TRIANGULATION_BUFFER of them */
+static int      tri_record, tri_buffered;
+   /* size of one record in bytes and number of records in the buffer */
+static long int tri_count;
+   /* number of simplices written */
+static int      *sample_simplex = NULL;
+   /* if not NULL, the numbers of the vertices of all simplices, G_d + 1 for each, are  */
+   /* kept here for sampling points */
+static rational *sample_volume;
+   /* the volumes of the kept simplices */
+static int      sample_count, sample_size;
+   /* number of simplices kept and size of the arrays */
+static rational *moments = NULL;
+   /* if not NULL, the integrals of the monomials up to degree G_Moments */
+
+/* global variables for the method 'hybrid' */
+
+static boolean hybrid = FALSE;
+   /* whether faces may be handed to Lasserre's method */
+static int *incident;
+   /* number of vertices of the considered face in each hyperplane */
+static rational *lass_A;
+   /* inequality description of the considered face in its own affine hull */
+
+/* global variables for the session mode */
+
+static boolean  session = FALSE;
+   /* whether the polytope is modified interactively; then the volumes of facets are    */
+   /* stored as well */
+static T_Vertex **session_vertex;
+   /* all vertices created during the session, indexed by their numbers; numbers are    */
+   /* never reused, so that stored volumes remain valid after modifications */
+static int      session_count, session_size;
+   /* number of vertices created and size of session_vertex */
+static int      incidence_rows, incidence_columns;
+   /* dimensions of G_Incidence */
+
+/****************************************************************************************/
+
+static void create_direct ()
+   /* reserves the memory space needed by "direct_volume"; G_d and G_n must be set */
+
+{
+   local_X = create_matrix (G_n, 3);
+   local_x = create_vector ();
+   angle = (rational *) my_malloc (G_n * sizeof (rational));
+   order = create_int_vector (G_n);
+}
+
+/****************************************************************************************/
+
+static void free_direct ()
+
+{
+   free_matrix (local_X, G_n, 3);
+   free_vector (local_x);
+   my_free (angle, G_n * sizeof (rational));
+   free_int_vector (order, G_n);
+}
+
+/****************************************************************************************/
+
+static int compare_angles (const void *i, const void *j)
+   /* comparison function for sorting positions by their angles with qsort */
+
+{  rational a = angle [* (int *) i], b = angle [* (int *) j];
+
+   if      (a < b) return -1;
+   else if (a > b) return 1;
+   else            return 0;
+}
+
+/****************************************************************************************/
+
+static void cyclic_order (int k, int dim)
+   /* The positions in order [0] to order [k-1] designate the vertices of a convex      */
+   /* polygon whose coordinates are stored in local_X, dim (2 or 3) of them each.       */
+   /* The positions are sorted such that the vertices follow each other on the          */
+   /* boundary of the polygon.                                                          */
+
+{  int      i, j;
+   rational c [3], u [3], w [3], p [3], q [3], n [3], length, maxlength;
+
+   for (j = 0; j < 3; j++)
+      c [j] = u [j] = w [j] = n [j] = 0;
+   for (i = 0; i < k; i++)
+      for (j = 0; j < dim; j++)
+         c [j] += local_X [order [i]] [j] / k;
+
+   if (dim == 2)
+   {  u [0] = 1;
+      w [1] = 1;
+   }
+   else
+   {  /* u points from the centre to the farthest vertex, w is orthogonal to u in the   */
+      /* plane of the polygon                                                           */
+      maxlength = -1;
+      for (i = 0; i < k; i++)
+      {  for (j = 0, length = 0; j < 3; j++)
+         {  p [j] = local_X [order [i]] [j] - c [j];
+            length += p [j] * p [j];
+         }
+         if (length > maxlength)
+         {  maxlength = length;
+            for (j = 0; j < 3; j++)
+               u [j] = p [j];
+         }
+      }
+      maxlength = -1;
+      for (i = 0; i < k; i++)
+      {  for (j = 0; j < 3; j++)
+            p [j] = local_X [order [i]] [j] - c [j];
+         q [0] = u [1] * p [2] - u [2] * p [1];
+         q [1] = u [2] * p [0] - u [0] * p [2];
+         q [2] = u [0] * p [1] - u [1] * p [0];
+         length = q [0] * q [0] + q [1] * q [1] + q [2] * q [2];
+         if (length > maxlength)
+         {  maxlength = length;
+            for (j = 0; j < 3; j++)
+               n [j] = q [j];
+         }
+      }
+      w [0] = n [1] * u [2] - n [2] * u [1];
+      w [1] = n [2] * u [0] - n [0] * u [2];
+      w [2] = n [0] * u [1] - n [1] * u [0];
+   }
+
+   for (i = 0; i < k; i++)
+   {  for (j = 0; j < 3; j++)
+         p [j] = (j < dim ? local_X [order [i]] [j] - c [j] : 0);
+      angle [order [i]] = atan2 (p [0] * w [0] + p [1] * w [1] + p [2] * w [2],
+                                 p [0] * u [0] + p [1] * u [1] + p [2] * u [2]);
+   }
+   qsort (order, k, sizeof (int), compare_angles);
+}
+
+/****************************************************************************************/
+
+static rational direct_volume (int d, rational **H, T_Vertex **ref, rational *ref_volume)
+   /* computes d! times the volume of face [d] for d = 2 or 3 without recursion; H must */
+   /* contain the Householder vectors of face [d] as computed by "orthonormal".         */
+   /* The face is decomposed into the simplices formed by its first vertex and the      */
+   /* triangles of a fan triangulation of each facet not containing it, where a polygon */
+   /* is its own facet. The facets are found by intersecting with the hyperplanes and   */
+   /* ordered cyclically by their angles in the affine hull of the face.                */
+   /* If ref is not NULL, the vertices of the biggest simplex are returned via ref and  */
+   /* d! times its volume via ref_volume; the first vertex of face [d] is ref [0].      */
+
+{  int              i, j, k, l, n = face [d].lastel + 1;
+   T_VertexSuperset *L = create_empty_superset ();
+      /* L contains the facets already examined */
+   rational         volume = 0, part, best = 0, *p, *q, *r;
+
+   for (i = 0; i < n; i++)
+   {  local_coordinates (d, H, face [d].loe [0], face [d].loe [i], local_x);
+      for (j = 0; j < d; j++)
+         local_X [i] [j] = local_x [j];
+   }
+   if (ref != NULL)
+      ref [0] = face [d].loe [0];
+
+   if (d == 2)
+   {  for (i = 0; i < n; i++)
+         order [i] = i;
+      cyclic_order (n, 2);
+      /* start the fan at the first vertex, which lies in the origin */
+      for (l = 0; order [l] != 0; l++);
+      for (i = 1; i < n - 1; i++)
+      {  q = local_X [order [(l + i) % n]];
+         r = local_X [order [(l + i + 1) % n]];
+         part = fabs (q [0] * r [1] - q [1] * r [0]);
+         volume += part;
+         if (ref != NULL && part > best)
+         {  best = part;
+            ref [1] = face [d].loe [order [(l + i) % n]];
+            ref [2] = face [d].loe [order [(l + i + 1) % n]];
+         }
+      }
+   }
+   else
+      for (k = 0; k < G_m; k++)
+         if (! is_in_hyperplane (face [d].loe [0], k))
+         {  intersect_with_hyperplane (face [d], k, &(face [d-1]));
+            if ((face [d-1]).lastel >= 2 && !is_in_superset (face [d-1], L))
+            {  add_superelement_in_arena (&(arena [d]), &L,
+                                          duplicate_set_in_arena (&(arena [d]), face [d-1]));
+               /* look up the positions of the vertices of the facet in face [d] */
+               for (i = j = 0; i <= face [d-1].lastel; i++)
+               {  while (face [d].loe [j] != face [d-1].loe [i]) j++;
+                  order [i] = j;
+               }
+               cyclic_order (face [d-1].lastel + 1, 3);
+               p = local_X [order [0]];
+               for (i = 1; i < face [d-1].lastel; i++)
+               {  q = local_X [order [i]];
+                  r = local_X [order [i+1]];
+                  part = fabs (  p [0] * (q [1] * r [2] - q [2] * r [1])
+                               - p [1] * (q [0] * r [2] - q [2] * r [0])
+                               + p [2] * (q [0] * r [1] - q [1] * r [0]));
+                  volume += part;
+                  if (ref != NULL && part > best)
+                  {  best = part;
+                     ref [1] = face [d].loe [order [0]];
+                     ref [2] = face [d].loe [order [i]];
+                     ref [3] = face [d].loe [order [i+1]];
+                  }
+               }
+            }
+         }
+
+   if (ref != NULL)
+      *ref_volume = best;
+   return volume;
+}
+
+/****************************************************************************************/
+
+static boolean hybrid_volume (int d, rational *V)
+   /* decides by the heuristic described with HYBRID_BIAS whether the volume of face    */
+   /* [d] should be computed by Lasserre's method. If so, it is returned in V as in     */
+   /* "tri_ortho", ortho_basis [d] is set and the return value is TRUE; otherwise FALSE */
+   /* is returned. Only hyperplanes containing at least d, but not all vertices of the  */
+   /* face are passed; they comprise its facets. The local_x vector of the direct       */
+   /* evaluation serves as work space.                                                  */
+
+{  int      i, j, k, n = face [d].lastel + 1, f = 0, rows = 0;
+   rational *row;
+
+   for (k = 0; k < G_m; k++)
+   {  incident [k] = 0;
+      for (i = 0; i < n; i++)
+         if (is_in_hyperplane (face [d].loe [i], k))
+            incident [k]++;
+      if (incident [k] >= d && incident [k] < n)
+         f++;
+   }
+
+   if (HYBRID_BIAS * (rational) f * f * d * factorial (d - 1) >= (rational) n * G_m)
+      return FALSE;
+
+   if (orthonormal (d, face [d], ortho_basis [d]) == 0)
+   {  *V = 0;
+      return TRUE;
+   }
+
+   /* a x <= b becomes (U^T a) y <= b - a v for x = v + U y, where v is the first      */
+   /* vertex and the columns of U are the basis of the face                             */
+   for (k = 0; k < G_m; k++)
+      if (incident [k] >= d && incident [k] < n)
+      {  row = lass_A + rows * (d + 1);
+         row [d] = G_Hyperplanes [k] [G_d];
+         for (j = 0; j < G_d; j++)
+         {  local_x [j] = G_Hyperplanes [k] [j];
+            row [d] -= G_Hyperplanes [k] [j] * face [d].loe [0] -> coords [j];
+         }
+         apply_householder (d, ortho_basis [d], local_x);
+         for (j = 0; j < d; j++)
+            row [j] = local_x [j];
+         rows++;
+      }
+
+   *V = volume_lasserre (lass_A, rows, d) * factorial (d);
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+static void flush_simplices ()
+   /* writes the buffered simplices to tri_file */
+
+{
+   if (fwrite (tri_buffer, tri_record, tri_buffered, tri_file) != tri_buffered)
+   {  fprintf (stderr, "\n***** ERROR: Could not write to file '%s' in 'flush_simplices'.\n",
+               G_TriangulationFile);
+      exit (0);
+   }
+   tri_buffered = 0;
+}
+
+/****************************************************************************************/
+
+static void write_simplex (rational volume)
+   /* adds the simplex S with G_d! times its volume to the buffer of tri_file */
+
+{  int    i, *id = (int *) (tri_buffer + tri_buffered * tri_record);
+   double det = (double) volume;
+
+   for (i = 0; i <= G_d; i++)
+      id [i] = tri_id [S.loe [i] -> no];
+   memcpy (id + G_d + 1, &det, sizeof (double));
+   tri_count++;
+   if (++tri_buffered == TRIANGULATION_BUFFER)
+      flush_simplices ();
+}
+
+/****************************************************************************************/
+
+static void keep_simplex (rational volume)
+   /* adds the simplex S with G_d! times its volume to sample_simplex and sample_volume */
+
+{  int i;
+
+   if (sample_count == sample_size)
+   {  sample_simplex = (int *) my_realloc (sample_simplex,
+                          2 * sample_size * (G_d + 1) * sizeof (int),
+                          sample_size * (G_d + 1) * sizeof (int));
+      sample_volume = (rational *) my_realloc (sample_volume,
+                          2 * sample_size * sizeof (rational), sample_size * sizeof (rational));
+      sample_size *= 2;
+   }
+   for (i = 0; i <= G_d; i++)
+      sample_simplex [sample_count * (G_d + 1) + i] = S.loe [i] -> no;
+   sample_volume [sample_count++] = volume;
+}
 
 /****************************************************************************************/
 
@@ -46,9 +403,28 @@ static void tri (int d, rational *V)
 {  int              k;
    T_VertexSuperset *L = create_empty_superset ();
       /* L contains the faces already examined in this recursion step */
-   rational         volume;
-
-   if (face [d].lastel > d)
+   rational         volume, local_volume, ref_volume;
+   T_Vertex         *ref [DIRECT_FACES + 1];
+
+   if (face [d].lastel > d && d >= 2 && d <= DIRECT_FACES
+       && tri_file == NULL && sample_simplex == NULL && moments == NULL)
+   {  /* All simplices of a triangulation of face [d] are completed by the same ver-   */
+      /* tices in S, so that their volumes are proportional to their volumes in the    */
+      /* face. Thus one simplex, the biggest one found, suffices to scale the volume   */
+      /* of face [d] evaluated directly in its affine hull.                            */
+      if (orthonormal (d, face [d], ortho_basis [d]) > 0)
+      {  local_volume = direct_volume (d, ortho_basis [d], ref, &ref_volume);
+         if (ref_volume > 0)
+         {  for (k = 1; k <= d; k++)
+               add_element (&S, ref [k]);
+            simplex_volume (S, &volume, FALSE);
+            *V += volume * local_volume / ref_volume;
+            for (k = 1; k <= d; k++)
+               delete_element (&S, ref [k]);
+         }
+      }
+   }
+   else if (face [d].lastel > d)
    {  /* cut face [d] with all hyperplanes. If the result is appropriate, start        */
       /* recursion.                                                                    */
       for (k = 0; k < G_m; k++)
@@ -63,7 +439,8 @@ static void tri (int d, rational *V)
 
             /* determine whether face [d-1] is a new face and possibly of dimension d-1 */
             if ((face [d-1]).lastel >= d - 1 && !is_in_superset (face [d-1], L))
-            {  add_superelement (&L, duplicate_set (face [d-1]));
+            {  add_superelement_in_arena (&(arena [d]), &L,
+                                          duplicate_set_in_arena (&(arena [d]), face [d-1]));
                add_element (&S, (face [d-1]).loe [0]);
 
                tri (d - 1, V);
@@ -80,10 +457,16 @@ static void tri (int d, rational *V)
       /* compute the volume of the simplex defined by S; S may be of empty interior! */
       simplex_volume (S, &volume, FALSE);
       *V += volume;
+      if (tri_file != NULL && volume > EPSILON)
+         write_simplex (volume);
+      if (sample_simplex != NULL && volume > EPSILON)
+         keep_simplex (volume);
+      if (moments != NULL && volume > EPSILON)
+         simplex_moments (S, volume, moments);
       for (k = 1; k <= face [d].lastel; k++)
          delete_element (&S, (face [d]).loe [k]);
    }
-   free_superset (&L);
+   clear_arena (&(arena [d]));
 }
 
 /****************************************************************************************/
@@ -95,19 +478,61 @@ void volume_ch_file (rational *volume, char *vertexfile, char *planesfile)
 
 {
    rational local_volume = 0;
+   int      i, j, k, count = 0, *e;
+   T_Vertex **input = NULL;
 
-   read_vertices (vertexfile);
-   read_hyperplanes (planesfile);
-   compute_incidence ();
+   read_polytope (vertexfile, planesfile);
+
+   if (G_TriangulationFile != NULL)
+   {  /* remember the input order of the vertices */
+      input = (T_Vertex **) my_malloc (G_n * sizeof (T_Vertex *));
+      memcpy (input, G_Vertices.loe, G_n * sizeof (T_Vertex *));
+   }
 
    /* renumber vertices such that highly degenerate ones get a lower number */
    renumber_vertices ();
 
+   if (G_TriangulationFile != NULL)
+   {  if (! (tri_file = fopen (G_TriangulationFile, "wb")))
+      {  fprintf (stderr, "\n***** ERROR: Could not open file '%s' in 'volume_ch_file'.\n",
+                  G_TriangulationFile);
+         exit (0);
+      }
+      tri_id = create_int_vector (G_n);
+      for (i = 0; i < G_n; i++)
+         tri_id [input [i] -> no] = i;
+      my_free (input, G_n * sizeof (T_Vertex *));
+      tri_record = (G_d + 1) * sizeof (int) + sizeof (double);
+      tri_buffer = (char *) my_malloc (TRIANGULATION_BUFFER * tri_record);
+      tri_buffered = 0;
+      tri_count = 0;
+      fwrite ("VINCITR1", 1, 8, tri_file);
+      fwrite (&G_d, sizeof (int), 1, tri_file);
+      fwrite (&G_n, sizeof (int), 1, tri_file);
+   }
+
+   if (G_SampleFile != NULL)
+   {  sample_size = G_n;
+      sample_count = 0;
+      sample_simplex = create_int_vector (sample_size * (G_d + 1));
+      sample_volume = (rational *) my_malloc (sample_size * sizeof (rational));
+   }
+
+   if (G_Moments > 0)
+   {  count = init_moments (G_Moments);
+      moments = (rational *) my_malloc (count * sizeof (rational));
+      for (k = 0; k < count; k++)
+         moments [k] = 0;
+   }
+
    /* preparing the global variables */
    face = create_faces ();
    copy_set (G_Vertices, &(face [G_d]));
    S = create_empty_set ();
    add_element (&S, G_Vertices.loe [0]);
+   arena = create_arenas ();
+   ortho_basis = create_basis ();
+   create_direct ();
 
 #ifdef STATISTICS
    init_statistics ();
@@ -117,18 +542,139 @@ void volume_ch_file (rational *volume, char *vertexfile, char *planesfile)
 
    tri (G_d, &local_volume);
 
+   if (tri_file != NULL)
+   {  flush_simplices ();
+      fclose (tri_file);
+      tri_file = NULL;
+      printf ("\n%li simplices written to '%s'.", tri_count, G_TriangulationFile);
+      free_int_vector (tri_id, G_n);
+      my_free (tri_buffer, TRIANGULATION_BUFFER * tri_record);
+   }
+
+   if (sample_simplex != NULL)
+   {  sample_points (G_SampleFile, G_SampleSize, sample_simplex, sample_volume,
+                     sample_count);
+      printf ("\n%li points sampled from %i simplices written to '%s'.", G_SampleSize,
+              sample_count, G_SampleFile);
+      free_int_vector (sample_simplex, sample_size * (G_d + 1));
+      my_free (sample_volume, sample_size * sizeof (rational));
+      sample_simplex = NULL;
+   }
+
    /* The real volume is local_volume / (factorial of dimension) */
    (*volume) = local_volume / factorial (G_d);
 
+   if (moments != NULL)
+   {  printf ("\n\nIntegrals of the monomials up to degree %i (exponents, integral):", G_Moments);
+      for (k = 0; k < count; k++)
+      {  e = monomial_exponents (k);
+         printf ("\n");
+         for (j = 0; j < G_d; j++)
+            printf ("%3i", e [j]);
+         printf ("   %20.12e", moments [k]);
+      }
+      printf ("\n\nCentroid:");
+      for (j = 0; j < G_d; j++)
+         printf ("\n   %20.12e", moments [1 + j] / (*volume));
+      my_free (moments, count * sizeof (rational));
+      moments = NULL;
+      free_moments ();
+   }
+
    free_incidence ();
    free_set (S);
    free_faces (face);
+   free_arenas (arena);
+   free_basis (ortho_basis);
+   free_direct ();
+   free_hyperplanes ();
    free_set_and_vertices (G_Vertices);
 
 }
 
 /****************************************************************************************/
 
+static int compare_ints (const void *p, const void *q)
+
+{
+   return (*(const int *) p - *(const int *) q);
+}
+
+/****************************************************************************************/
+
+static rational * dump_slot (int d)
+   /* returns the place where the volume of face [d] is kept in dump_tree; it is -1 if  */
+   /* the face has not yet been visited                                                 */
+
+{  boolean  i_balance = FALSE;
+   rational *slot;
+   T_Key    *dummy;
+
+   copy_set (face [d], &(dump_key.vertices.set));
+   dump_key.vertices.d = d;
+   tree_out (&dump_tree, &i_balance, dump_key, &slot, &dummy, KEY_VERTICES);
+   return slot;
+}
+
+/****************************************************************************************/
+
+static boolean dump_face (int d, rational V)
+   /* writes the volume of face [d] as computed by "tri_ortho" to dump_file, unless the */
+   /* face has been written before, it is of lower dimension or of a dimension below    */
+   /* G_DumpDim. A record consists of the dimension, the numbers of vertices and of     */
+   /* hyperplanes, the vertices and the hyperplanes containing the face, both with      */
+   /* their input numbers in ascending order, as int, and the volume as double.         */
+   /* Returns TRUE if the face has not been visited before.                            */
+
+{  rational *slot = dump_slot (d);
+   int      i, k, planes = 0, n = face [d].lastel + 1;
+   double   volume = V / factorial (d);
+
+   if (*slot > -0.5)
+      return FALSE;
+   *slot = V;
+
+   if (V > EPSILON && d >= G_DumpDim)
+   {  for (i = 0; i < n; i++)
+         dump_record [i] = dump_id [face [d].loe [i] -> no];
+      qsort (dump_record, n, sizeof (int), compare_ints);
+      for (k = 0; k < G_m; k++)
+      {  i = 0;
+         while (i < n && is_in_hyperplane (face [d].loe [i], k))
+            i++;
+         if (i == n)
+            dump_record [n + planes++] = k;
+      }
+      fwrite (&d, sizeof (int), 1, dump_file);
+      fwrite (&n, sizeof (int), 1, dump_file);
+      fwrite (&planes, sizeof (int), 1, dump_file);
+      fwrite (dump_record, sizeof (int), n + planes, dump_file);
+      fwrite (&volume, sizeof (double), 1, dump_file);
+      dump_count++;
+   }
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+static void dump_subfaces (int d)
+   /* visits all facets of face [d] which have not been visited before, so that all     */
+   /* faces down to dimension G_DumpDim are written, including those which are not     */
+   /* needed for the volume computation                                                 */
+
+{  int      k;
+   rational volume;
+
+   for (k = 0; k < G_m; k++)
+   {  intersect_with_hyperplane (face [d], k, &(face [d-1]));
+      if ((face [d-1]).lastel + 1 >= d && (face [d-1]).lastel < (face [d]).lastel
+          && *dump_slot (d - 1) < -0.5)
+         tri_ortho (d - 1, &volume);
+   }
+}
+
+/****************************************************************************************/
+
 void tri_ortho (int d, rational *V)
    /* After recursion V contains the volume of the actually considered face (stored in  */
    /* the global variable face [d]), and the global variable ortho_basis [d] contains   */
@@ -149,11 +695,18 @@ void tri_ortho (int d, rational *V)
    {
       /* if possible try to retrieve the volume */
       dimdiff = G_d - d;
-      if ((G_Storage > (dimdiff-2)) && (dimdiff >= 2))
+      if (((G_Storage > (dimdiff-2)) && (dimdiff >= 2))
+          || (session && dimdiff == 1 && G_Storage > 0))
       {
-         copy_set (face [d], &(key.vertices.set));
+         if (symmetric)
+            canonical_face (face [d], &(key.vertices.set));
+         else
+            copy_set (face [d], &(key.vertices.set));
          key.vertices.d = d;
          tree_out (&tree_volumes, &i_balance, key, &stored_volume, &dummy, KEY_VERTICES);
+         if (*stored_volume < -0.5 && cache)
+            /* the face is new in the tree; the volume may have been spilled before */
+            cache_added (&tree_volumes, key, stored_volume);
          if (*stored_volume < -0.5)  /* volume has not yet been computed and is -1 */
             /* stored_volume points to a tree element where the volume has to be stored */
             store_volume = TRUE;
@@ -180,6 +733,14 @@ void tri_ortho (int d, rational *V)
 
       if (compute_volume) /* do so */
       {
+         if (d >= 2 && d <= DIRECT_FACES)
+         {  /* evaluate the face directly in the basis computed by orthonormal */
+            if (orthonormal (d, face [d], ortho_basis [d]) > 0)
+               *V = direct_volume (d, ortho_basis [d], NULL, NULL);
+         }
+         else if (hybrid && d < G_d && hybrid_volume (d, V))
+            ;
+         else
          /* cut face [d] with all hyperplanes. If the result is appropriate, start      */
          /* recursion. */
          for (k = 0; k < G_m; k++)
@@ -188,7 +749,7 @@ void tri_ortho (int d, rational *V)
             if (! is_in_hyperplane ((face [d]).loe [0], k))
             {  /* let face [d-1] be the face (face [d] intersected with hyperplane k) */
 
-               if (d == G_d)
+               if (d == G_d && !session)
                   printf ("\nStarting hyperplane %i", k+1);
                intersect_with_hyperplane (face [d], k, &(face [d-1]));
 
@@ -196,7 +757,8 @@ void tri_ortho (int d, rational *V)
                /* d-1 */
                if ((face [d-1]).lastel + 1 >= d && !is_in_superset (face [d-1], L))
                {
-                  add_superelement (&L, duplicate_set (face [d-1]));
+                  add_superelement_in_arena (&(arena [d]), &L,
+                                             duplicate_set_in_arena (&(arena [d]), face [d-1]));
 
                   tri_ortho (d - 1, &volume);
 
@@ -241,7 +803,40 @@ void tri_ortho (int d, rational *V)
       *V = orthonormal (d, face [d], ortho_basis [d]);
    }
 
-   free_superset (&L);
+   if (dump_file != NULL && (d == G_d || dump_face (d, *V)) && d > G_DumpDim && G_DumpDim > 0)
+      dump_subfaces (d);
+
+   clear_arena (&(arena [d]));
+}
+
+/****************************************************************************************/
+
+static void tri_ortho_symmetric (rational *V)
+   /* replaces "tri_ortho" on the top level if symmetries have been found: the polytope */
+   /* is decomposed into pyramids over its facets with the common apex in the centre of */
+   /* symmetry, and only one facet per orbit is considered, weighted by the size of the */
+   /* orbit. The centre is the centroid of the vertices and thus in the polytope.       */
+
+{  int      k, *weight = orbit_weights ();
+   rational volume, distance;
+   T_Vertex apex;
+
+   apex.coords = symmetry_centre ();
+   apex.no = -1;
+   *V = 0;
+
+   for (k = 0; k < G_m; k++)
+      if (weight [k] > 0 && plane_representative (k) == k)
+      {  printf ("\nStarting hyperplane %i", k+1);
+         intersect_with_hyperplane (face [G_d], k, &(face [G_d-1]));
+         if ((face [G_d-1]).lastel + 1 >= G_d)
+         {  tri_ortho (G_d - 1, &volume);
+            if (fabs (volume) > EPSILON)
+            {  distance = add_orthonormal (G_d, face [G_d-1], ortho_basis [G_d-1], &apex);
+               *V += weight [k] * volume * distance;
+            }
+         }
+      }
 }
 
 /****************************************************************************************/
@@ -253,25 +848,57 @@ void volume_ortho_file (rational *volume, char *vertexfile, char *planesfile)
 
 {
    T_VertexSet vertices = create_empty_set ();
-   rational local_volume = 0, scaling_factor;
+   rational local_volume = 0, scaling_factor = 1, *centroid;
+   int      i, j;
+   T_Vertex **input = NULL;
 
-   read_vertices (vertexfile);
-   read_hyperplanes (planesfile);
-   compute_incidence ();
+   read_polytope (vertexfile, planesfile);
+
+   if (G_DumpFile != NULL)
+   {  /* remember the input order of the vertices */
+      input = (T_Vertex **) my_malloc (G_n * sizeof (T_Vertex *));
+      memcpy (input, G_Vertices.loe, G_n * sizeof (T_Vertex *));
+   }
 
    /* renumber vertices such that highly degenerate ones get a lower number */
    renumber_vertices ();
 
    /* normalise the vertices so that their coefficients are between -1 and 1; this is   */
    /* necessary because otherwise a too big polytope has caused numerical errors        */
-   scaling_factor = normalise_vertices ();
+   /* When face volumes are dumped, they must be those of the original polytope.        */
+   if (G_DumpFile == NULL)
+      scaling_factor = normalise_vertices ();
+   else
+   {  if (! (dump_file = fopen (G_DumpFile, "wb")))
+      {  fprintf (stderr, "\n***** ERROR: Could not open file '%s' in 'volume_ortho_file'.\n",
+                  G_DumpFile);
+         exit (0);
+      }
+      dump_id = create_int_vector (G_n);
+      for (i = 0; i < G_n; i++)
+         dump_id [input [i] -> no] = i;
+      my_free (input, G_n * sizeof (T_Vertex *));
+      dump_record = create_int_vector (G_n + G_m);
+      dump_key.vertices.set = create_empty_set ();
+      dump_tree = NULL;
+      dump_count = 0;
+      fwrite ("VINCIFV1", 1, 8, dump_file);
+      fwrite (&G_d, sizeof (int), 1, dump_file);
+      fwrite (&G_n, sizeof (int), 1, dump_file);
+      fwrite (&G_m, sizeof (int), 1, dump_file);
+   }
 
    /* preparing the global variables */
    face = create_faces();
    free_set(face[G_d]);
    face[G_d] = duplicate_set(G_Vertices);
    ortho_basis = create_basis();
+   arena = create_arenas ();
+   create_direct ();
    tree_volumes = NULL;
+   cache = (G_CacheFile != NULL || G_CacheMemory >= 0);
+   if (cache)
+      create_cache ();
 
 #ifdef STATISTICS
    init_statistics ();
@@ -280,9 +907,48 @@ void volume_ortho_file (rational *volume, char *vertexfile, char *planesfile)
    key.vertices.set = create_empty_set ();
    key.vertices.d   = G_d;
 
+   if (hybrid)
+   {  incident = create_int_vector (G_m);
+      lass_A = (rational *) my_malloc (G_m * (G_d + 1) * sizeof (rational));
+   }
+
+   symmetric = FALSE;
+   if (G_SymmetryFile != NULL)
+   {  centroid = create_vector ();
+      for (j = 0; j < G_d; j++)
+      {  centroid [j] = 0;
+         for (i = 0; i < G_n; i++)
+            centroid [j] += G_Vertices.loe [i] -> coords [j];
+         centroid [j] /= G_n;
+      }
+      symmetric = (compute_symmetries (G_SymmetryFile, centroid) > 0);
+      free_vector (centroid);
+   }
+
    printf ("\nTotal number of hyperplanes: %i\n", G_m);
 
-   tri_ortho (G_d, &local_volume);
+   if (symmetric)
+   {  tri_ortho_symmetric (&local_volume);
+      if (dump_file != NULL && G_DumpDim > 0 && G_DumpDim < G_d)
+         dump_subfaces (G_d);
+   }
+   else
+      tri_ortho (G_d, &local_volume);
+
+   if (dump_file != NULL)
+   {  fclose (dump_file);
+      dump_file = NULL;
+      printf ("\n%li face volumes written to '%s'.", dump_count, G_DumpFile);
+      free_int_vector (dump_id, G_n);
+      free_int_vector (dump_record, G_n + G_m);
+      free_set (dump_key.vertices.set);
+      free_tree (dump_tree, KEY_VERTICES);
+   }
+
+   if (cache)
+   {  free_cache ();
+      cache = FALSE;
+   }
 
    /* The real volume of the scaled polytope is local_volume / (factorial of dimension) */
    (*volume) = scaling_factor * local_volume / factorial (G_d);
@@ -290,9 +956,449 @@ void volume_ortho_file (rational *volume, char *vertexfile, char *planesfile)
    free_incidence();
    free_faces(face);
    free_basis(ortho_basis);
+   free_arenas (arena);
+   free_direct ();
+   if (hybrid)
+   {  free_int_vector (incident, G_m);
+      my_free (lass_A, G_m * (G_d + 1) * sizeof (rational));
+      free_lasserre ();
+   }
+   if (G_SymmetryFile != NULL)
+   {  free_symmetries ();
+      symmetric = FALSE;
+   }
+   free_tree (tree_volumes, KEY_VERTICES);
+   tree_volumes = NULL;
+   free_set (key.vertices.set);
    free_set_and_vertices (vertices);
+   free_hyperplanes ();
+   free_set_and_vertices (G_Vertices);
+}
+
+/****************************************************************************************/
+
+void volume_hybrid_file (rational *volume, char *vertexfile, char *planesfile)
+   /* computes the volume as "volume_ortho_file", but hands those faces to Lasserre's   */
+   /* method for which this promises to be cheaper, see "hybrid_volume"                 */
+
+{
+   hybrid = TRUE;
+   volume_ortho_file (volume, vertexfile, planesfile);
+   hybrid = FALSE;
+}
+
+/****************************************************************************************/
+
+static T_Vertex *session_new_vertex (rational *x)
+   /* creates a vertex with coordinates x and the next free number */
+
+{  T_Vertex *v = create_vertex ();
+
+   memcpy (v -> coords, x, G_d * sizeof (rational));
+   if (session_count == session_size)
+   {  session_vertex = (T_Vertex **) my_realloc (session_vertex,
+                          2 * session_size * sizeof (T_Vertex *),
+                          session_size * sizeof (T_Vertex *));
+      session_size *= 2;
+   }
+   v -> no = session_count;
+   session_vertex [session_count++] = v;
+   return v;
+}
+
+/****************************************************************************************/
+
+static rational slack (real *plane, T_Vertex *v)
+   /* returns b - a v for the hyperplane a x <= b */
+
+{  int      j;
+   rational s = plane [G_d];
+
+   for (j = 0; j < G_d; j++)
+      s -= plane [j] * v -> coords [j];
+   return s;
+}
+
+/****************************************************************************************/
+
+static void session_incidence (T_VertexSet s)
+   /* recomputes G_Incidence for the vertices of s; it gets a row for each vertex of    */
+   /* the session, but the rows of vertices not in s are undefined */
+
+{  int i, j;
+
+   for (i = 0; i < incidence_rows; i++)
+      my_free (G_Incidence [i], incidence_columns * sizeof (boolean));
+   my_free (G_Incidence, incidence_rows * sizeof (boolean *));
+
+   incidence_rows = session_count;
+   incidence_columns = G_m;
+   G_Incidence = (boolean **) my_malloc (incidence_rows * sizeof (boolean *));
+   for (i = 0; i < incidence_rows; i++)
+      G_Incidence [i] = (boolean *) my_malloc (incidence_columns * sizeof (boolean));
+
+   for (i = 0; i <= s.lastel; i++)
+      for (j = 0; j < G_m; j++)
+         G_Incidence [s.loe [i] -> no] [j] =
+            (fabs (slack (G_Hyperplanes [j], s.loe [i])) < INCIDENCE_EPSILON);
+}
+
+/****************************************************************************************/
+
+static boolean session_adjacent (T_Vertex *v, T_Vertex *w, boolean *common)
+   /* tests whether v and w span an edge of the polytope G_Vertices, which is the case  */
+   /* if no other vertex lies in all hyperplanes containing both */
+
+{  int i, j, count = 0;
+
+   for (j = 0; j < G_m; j++)
+   {  common [j] = is_in_hyperplane (v, j) && is_in_hyperplane (w, j);
+      if (common [j])
+         count++;
+   }
+   if (count < G_d - 1)
+      return FALSE;
+
+   for (i = 0; i <= G_Vertices.lastel; i++)
+      if (G_Vertices.loe [i] != v && G_Vertices.loe [i] != w)
+      {  j = 0;
+         while (j < G_m && (!common [j] || is_in_hyperplane (G_Vertices.loe [i], j)))
+            j++;
+         if (j == G_m)
+            return FALSE;
+      }
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+static rational cap_volume (T_VertexSet cap)
+   /* computes the volume of the polytope with vertex set cap by "tri_ortho"; the faces */
+   /* stored before are reused. */
+
+{  rational V;
+
+   free_direct ();
+   G_n = cap.lastel + 1;
+   create_direct ();
+   copy_set (cap, &(face [G_d]));
+   tri_ortho (G_d, &V);
+   return V / factorial (G_d);
 }
 
+/****************************************************************************************/
+
+static boolean session_add (real *plane, rational *volume)
+   /* intersects the polytope with the halfspace a x <= b given by plane and updates    */
+   /* the volume by subtracting the volume of the cap cut off. The vertices of the cap  */
+   /* are those cut off, those on the hyperplane and the intersections of the           */
+   /* hyperplane with the edges leaving the halfspace. FALSE is returned if the command */
+   /* has to be ignored.                                                                */
+
+{  T_VertexSet keep = create_empty_set (), cap = create_empty_set (),
+               all = create_empty_set ();
+   T_Vertex    *v, *w;
+   rational    *s, *x, t;
+   boolean     *common, ok = TRUE;
+   int         i, j, k, n = G_Vertices.lastel + 1, inside = 0, outside = 0;
+
+   s = (rational *) my_malloc (n * sizeof (rational));
+   for (i = 0; i < n; i++)
+   {  v = G_Vertices.loe [i];
+      s [i] = slack (plane, v);
+      if (s [i] > - INCIDENCE_EPSILON)
+         add_element (&keep, v);
+      if (s [i] < INCIDENCE_EPSILON)
+         add_element (&cap, v);
+      if (s [i] >= INCIDENCE_EPSILON)
+         inside++;
+      else if (s [i] <= - INCIDENCE_EPSILON)
+         outside++;
+   }
+
+   if (inside == 0)
+   {  /* no vertex is strictly inside the halfspace */
+      printf ("\nThe polytope would become empty or lower dimensional; the command is ignored.");
+      ok = FALSE;
+   }
+   else
+   {  x = create_vector ();
+      common = (boolean *) my_malloc (G_m * sizeof (boolean));
+      for (i = 0; i < n; i++)
+         if (s [i] <= - INCIDENCE_EPSILON)
+            for (k = 0; k < n; k++)
+               if (s [k] >= INCIDENCE_EPSILON
+                   && session_adjacent (G_Vertices.loe [i], G_Vertices.loe [k], common))
+               {  v = G_Vertices.loe [i];
+                  w = G_Vertices.loe [k];
+                  t = s [i] / (s [i] - s [k]);
+                  for (j = 0; j < G_d; j++)
+                     x [j] = v -> coords [j] + t * (w -> coords [j] - v -> coords [j]);
+                  w = session_new_vertex (x);
+                  add_element (&keep, w);
+                  add_element (&cap, w);
+               }
+      free_vector (x);
+      my_free (common, G_m * sizeof (boolean));
+
+      G_Hyperplanes = (real **) my_realloc (G_Hyperplanes, (G_m + 1) * sizeof (real *),
+                                            sizeof (real *));
+      G_Hyperplanes [G_m] = (real *) my_malloc ((G_d + 1) * sizeof (real));
+      memcpy (G_Hyperplanes [G_m], plane, (G_d + 1) * sizeof (real));
+      G_m++;
+
+      copy_set (G_Vertices, &all);
+      for (i = 0; i <= keep.lastel; i++)
+         add_element (&all, keep.loe [i]);
+      session_incidence (all);
+
+      if (outside > 0)
+         *volume -= cap_volume (cap);
+      copy_set (keep, &G_Vertices);
+   }
+
+   my_free (s, n * sizeof (rational));
+   free_set (keep);
+   free_set (cap);
+   free_set (all);
+   return ok;
+}
+
+/****************************************************************************************/
+
+static boolean session_remove (int k, rational *volume)
+   /* removes hyperplane k and updates the volume by adding the volume of the cap       */
+   /* gained beyond it. The vertices of the enlarged polytope are enumerated by the     */
+   /* double description method and matched with the present ones, whose numbers are   */
+   /* kept. The cap is spanned by the new vertices beyond the hyperplane and the        */
+   /* present ones on it. FALSE is returned if the command has to be ignored.           */
+
+{  T_VertexSet larger = create_empty_set (), cap = create_empty_set (),
+               all = create_empty_set ();
+   T_Vertex    *v;
+   real        **planes;
+   rational    **X;
+   boolean     *matched;
+   int         i, j, l, n, m;
+
+   planes = (real **) my_malloc ((G_m - 1) * sizeof (real *));
+   for (i = 0, l = 0; i < G_m; i++)
+      if (i != k)
+         planes [l++] = G_Hyperplanes [i];
+   n = dd_vertices (planes, G_m - 1, &X);
+   my_free (planes, (G_m - 1) * sizeof (real *));
+
+   if (n < 0)
+   {  printf ("\nThe polytope would become unbounded; the command is ignored.");
+      free_set (larger);
+      free_set (cap);
+      free_set (all);
+      return FALSE;
+   }
+
+   m = G_Vertices.lastel + 1;
+   matched = (boolean *) my_malloc (m * sizeof (boolean));
+   for (i = 0; i < m; i++)
+      matched [i] = FALSE;
+   for (l = 0; l < n; l++)
+   {  v = NULL;
+      for (i = 0; i < m && v == NULL; i++)
+      {  j = 0;
+         while (j < G_d
+                && fabs (X [l] [j] - G_Vertices.loe [i] -> coords [j]) < INCIDENCE_EPSILON)
+            j++;
+         if (j == G_d)
+         {  v = G_Vertices.loe [i];
+            matched [i] = TRUE;
+         }
+      }
+      if (v == NULL)
+         v = session_new_vertex (X [l]);
+      add_element (&larger, v);
+      if (slack (G_Hyperplanes [k], v) < INCIDENCE_EPSILON)
+         add_element (&cap, v);
+   }
+   free_matrix (X, n, G_d);
+
+   /* the cap is also spanned by the present vertices on hyperplane k; those which    */
+   /* remain vertices have been matched and added above                               */
+   copy_set (larger, &all);
+   for (i = 0; i < m; i++)
+      if (!matched [i] && is_in_hyperplane (G_Vertices.loe [i], k))
+      {  add_element (&cap, G_Vertices.loe [i]);
+         add_element (&all, G_Vertices.loe [i]);
+      }
+   my_free (matched, m * sizeof (boolean));
+
+   session_incidence (all);
+   if (cap.lastel + 1 > G_d)
+      *volume += cap_volume (cap);
+
+   if (!in_binary_file (G_Hyperplanes [k]))
+      my_free (G_Hyperplanes [k], (G_d + 1) * sizeof (real));
+   for (i = k; i < G_m - 1; i++)
+      G_Hyperplanes [i] = G_Hyperplanes [i+1];
+   G_m--;
+   session_incidence (larger);
+   copy_set (larger, &G_Vertices);
+
+   free_set (larger);
+   free_set (cap);
+   free_set (all);
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+static void move_last_plane (int k)
+   /* moves the last hyperplane to position k */
+
+{  int  i;
+   real *plane = G_Hyperplanes [G_m - 1];
+
+   for (i = G_m - 1; i > k; i--)
+      G_Hyperplanes [i] = G_Hyperplanes [i-1];
+   G_Hyperplanes [k] = plane;
+   session_incidence (G_Vertices);
+}
+
+/****************************************************************************************/
+
+static boolean read_plane (real *plane)
+   /* reads a hyperplane in the format of the .ine-files from stdin */
+
+{  int j;
+
+   if (scanf ("%le", &(plane [G_d])) != 1)
+      return FALSE;
+   for (j = 0; j < G_d; j++)
+   {  if (scanf ("%le", &(plane [j])) != 1)
+         return FALSE;
+      plane [j] = - plane [j];
+   }
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+void volume_session_file (rational *volume, char *vertexfile, char *planesfile)
+   /* computes the volume as "volume_ortho_file" and afterwards reads commands from     */
+   /* stdin which modify the polytope, one per line:                                    */
+   /*    add b c_1 ... c_d      adds the inequality b + c x >= 0                         */
+   /*    remove k               removes the k-th inequality                              */
+   /*    move k b c_1 ... c_d   replaces the k-th inequality                             */
+   /*    volume                 prints the volume                                        */
+   /*    quit                                                                            */
+   /* After each modification the new volume is printed. It is obtained from the old    */
+   /* one by subtracting or adding the volume of the cap cut off or gained; the volumes */
+   /* of all faces computed so far are kept, so that only faces whose vertex sets are   */
+   /* new need to be computed. The vertices are not normalised.                         */
+
+{  rational local_volume = 0, *plane;
+   char     command [255];
+   int      i, k;
+   boolean  ok;
+
+   read_polytope (vertexfile, planesfile);
+   renumber_vertices ();
+   incidence_rows = G_n;
+   incidence_columns = G_m;
+
+   session_size = G_n;
+   session_count = G_n;
+   session_vertex = (T_Vertex **) my_malloc (session_size * sizeof (T_Vertex *));
+   for (i = 0; i < G_n; i++)
+      session_vertex [G_Vertices.loe [i] -> no] = G_Vertices.loe [i];
+
+   face = create_faces();
+   free_set(face[G_d]);
+   face[G_d] = duplicate_set(G_Vertices);
+   ortho_basis = create_basis();
+   arena = create_arenas ();
+   create_direct ();
+   tree_volumes = NULL;
+   session = TRUE;
+
+#ifdef STATISTICS
+   init_statistics ();
+#endif
+
+   key.vertices.set = create_empty_set ();
+   key.vertices.d   = G_d;
+
+   printf ("\nTotal number of hyperplanes: %i\n", G_m);
+   tri_ortho (G_d, &local_volume);
+   *volume = local_volume / factorial (G_d);
+
+   printf ("\nSession started; the commands are 'add', 'remove', 'move', 'volume' and 'quit'.");
+   printf ("\nVolume: %20.12e\n", *volume);
+   fflush (stdout);
+
+   plane = (real *) my_malloc ((G_d + 1) * sizeof (real));
+   while (scanf ("%254s", command) == 1 && strcmp (command, "quit"))
+   {  ok = TRUE;
+      k = 0;
+      if (!strcmp (command, "remove") || !strcmp (command, "move"))
+      {  if (scanf ("%i", &k) != 1 || k < 1 || k > G_m)
+         {  printf ("\nThe command '%s' needs the number of an existing hyperplane.", command);
+            ok = FALSE;
+         }
+         k--;
+      }
+      if (ok && (!strcmp (command, "add") || !strcmp (command, "move")) && !read_plane (plane))
+      {  printf ("\nThe command '%s' needs a hyperplane given by %i numbers.", command, G_d + 1);
+         ok = FALSE;
+      }
+
+      if (!ok)
+         ;
+      else if (!strcmp (command, "add"))
+         ok = session_add (plane, volume);
+      else if (!strcmp (command, "remove"))
+         ok = session_remove (k, volume);
+      else if (!strcmp (command, "move"))
+      {  /* the new hyperplane is added first, since the polytope may be unbounded */
+         /* without the old one                                                  */
+         ok = session_add (plane, volume);
+         if (ok)
+         {  if (session_remove (k, volume))
+               move_last_plane (k);
+            else
+            {  session_remove (G_m - 1, volume);
+               ok = FALSE;
+            }
+         }
+      }
+      else if (strcmp (command, "volume"))
+      {  printf ("\nThe command '%s' does not exist.", command);
+         ok = FALSE;
+      }
+
+      if (!ok)
+         /* skip the rest of the line */
+         while ((i = getchar ()) != EOF && i != EOLN);
+      printf ("\nVolume: %20.12e\n", *volume);
+      fflush (stdout);
+   }
+   my_free (plane, (G_d + 1) * sizeof (real));
+
+   session = FALSE;
+   for (i = 0; i < incidence_rows; i++)
+      my_free (G_Incidence [i], incidence_columns * sizeof (boolean));
+   my_free (G_Incidence, incidence_rows * sizeof (boolean *));
+   free_faces(face);
+   free_basis(ortho_basis);
+   free_arenas (arena);
+   free_direct ();
+   free_set (key.vertices.set);
+   for (i = 0; i < session_count; i++)
+      free_vertex (session_vertex [i]);
+   my_free (session_vertex, session_size * sizeof (T_Vertex *));
+   clear_set (&G_Vertices);
+}
+
+/****************************************************************************************/
+
 void volOrthoV(rational *volume)
 {
 	T_VertexSet vertices = create_empty_set();
@@ -304,6 +1410,8 @@ void volOrthoV(rational *volume)
    free_set(face[G_d]);
 	face[G_d] = duplicate_set(G_Vertices);
 	ortho_basis = create_basis();
+	arena = create_arenas();
+	create_direct();
 	tree_volumes = NULL;
 	key.vertices.set = create_empty_set ();
 	key.vertices.d = G_d;
@@ -312,6 +1420,8 @@ void volOrthoV(rational *volume)
 	free_incidence ();
 	free_faces (face);
 	free_basis (ortho_basis);
+	free_arenas (arena);
+	free_direct ();
 	free_set_and_vertices(vertices);
 
 }
@@ -322,20 +1432,27 @@ void volOrthoV(rational *volume)
 /****************************************************************************************/
 
 static void determine_c_and_d (rational *c, rational *d)
+   /* draws G_Objectives random objective functions, whose coefficients are stored one */
+   /* after the other in c; the constant term d is common to them                      */
 
-{  int i;
+{  int i, k;
 
    srand (G_RandomSeed); /* sets a seed for the random number generator */
 
-   printf ("\nCoordinates of the objective function c:");
-   for (i = 0; i < G_d; i++)
-   {  c [i] = (rational) rand ();
-      printf ("\nc [%i]: ", i);
+   for (k = 0; k < G_Objectives; k++)
+   {  if (G_Objectives == 1)
+         printf ("\nCoordinates of the objective function c:");
+      else
+         printf ("\nCoordinates of the objective function c_%i:", k + 1);
+      for (i = 0; i < G_d; i++)
+      {  c [k * G_d + i] = (rational) rand ();
+         printf ("\nc [%i]: ", i);
 #ifdef RATIONAL
-      cout << c [i];
+         cout << c [k * G_d + i];
 #else
-      printf ("%6.0f", c [i]);
+         printf ("%6.0f", c [k * G_d + i]);
 #endif
+      }
    }
    *d = 0;
    printf ("\nd: ");
@@ -349,68 +1466,761 @@ static void determine_c_and_d (rational *c, rational *d)
 
 /****************************************************************************************/
 
-static void volume_lawrence_set (T_VertexSet vertices, rational *volume)
+struct T_LawrenceJob
+       {int      first, last;  /* the range of vertices treated by the thread */
+        int      columns;      /* the number of columns of A */
+        rational **A;          /* the matrix of the thread */
+        rational *x;           /* the coordinates of the vertex */
+        boolean  *failed;      /* failed [k] tells whether a division by zero occurred */
+                               /* for objective function k */
+        int      *active;      /* the hyperplanes containing a degenerate vertex */
+        int      *subset;      /* positions in active of a cobasis, in increasing order */
+        int      *row;         /* row [p] is the row of A of active [p] if it belongs to */
+                               /* the cobasis and -1 otherwise */
+        int      *column;      /* column [p] is the column of A of active [p] otherwise */
+        rational *c;           /* the right hand side of the search for a first cobasis */
+        int      *bases;       /* the cobases found for the vertex, G_d positions each */
+        long int found, max_found, accounted;
+                               /* their number, the number of allocated ones and the */
+                               /* number of those known to the memory statistics */
+        long int degenerate, cobases;
+                               /* the number of degenerate vertices and of the cobases */
+                               /* into which they are split */
+        boolean  extended;     /* whether the summands are computed in G_Precision */
+        real     **normal;     /* the hyperplanes of the cobasis for "extended_summands" */
+        void     *work;        /* the work space of "extended_summands" */
+       };
+typedef struct T_LawrenceJob T_LawrenceJob;
+
+static T_VertexSet lawrence_vertices;
+   /* the vertices for Lawrence's formula */
+static rational    *lawrence_c, lawrence_d;
+   /* the objective functions */
+static int         *lawrence_cobasis;
+   /* the cobases read from lrs, G_d consecutive entries for each of them */
+static rational    *lawrence_term;
+   /* the summands of Lawrence's formula, G_Objectives consecutive entries for each */
+   /* vertex or cobasis */
+static rational    *lawrence_low = NULL;
+   /* in extended precision, the low order parts of the summands, which are then the  */
+   /* double-double numbers lawrence_term + lawrence_low */
+static int         *lawrence_redo;
+   /* for 'lawnd' in extended precision, whether the summands of a vertex are computed */
+   /* in double precision (0), are to be recomputed in extended precision (1) or have  */
+   /* been (2)                                                                         */
 
-{  int      v, i, j, k;
-   rational **A = create_matrix (G_d, G_d + 1);
-   rational *c = create_vector (), d;
-   rational Nv, fv;
-   
-   (*volume) = 0;
-   determine_c_and_d (c, &d);
-   
-   for (v = 0; v <= vertices.lastel; v++)
-   {  /* find the binding constraints for vertex v and write them (transposed!) in A */
-      j = k = 0;
-      while (k < G_m && j <= G_d)
-      {  /* check if v is contained in hyperplane k */
-         if (is_in_hyperplane (vertices.loe [v], k))
-         {  for (i = 0; i < G_d; i++)
-               A [i] [j] = G_Hyperplanes [k] [i];
-            j++;
+/****************************************************************************************/
+
+static void set_objectives (rational **A)
+   /* writes the objective functions into the columns G_d and following of A */
+
+{  int i, k;
+
+   for (k = 0; k < G_Objectives; k++)
+      for (i = 0; i < G_d; i++)
+         A [i] [G_d + k] = lawrence_c [k * G_d + i];
+}
+
+/****************************************************************************************/
+
+static void add_summands (T_LawrenceJob *job, rational det, rational *term, rational *low)
+   /* adds the summands of Lawrence's formula for all objective functions at the      */
+   /* vertex job -> x to term; the matrix job -> A of the binding constraints          */
+   /* (transposed) with the objective functions as right hand sides, set by          */
+   /* "set_objectives", has been factorised, and det is its determinant. The matrix   */
+   /* is thus factorised only once for all objective functions.                       */
+   /* If job -> extended is set, the summands are instead computed from the           */
+   /* hyperplanes job -> normal in extended precision and added to term + low.        */
+   /* A singular cobasis (det = 0) counts as a division by zero for all objective     */
+   /* functions.                                                                      */
+
+{  int      i, k;
+   rational **A = job -> A, *c, Nv, fv;
+
+   if (det == 0)
+   {  for (k = 0; k < G_Objectives; k++)
+         job -> failed [k] = TRUE;
+      return;
+   }
+   if (job -> extended)
+   {  extended_summands (job -> normal, job -> x, lawrence_c, lawrence_d, term, low,
+                         job -> failed, job -> work);
+      return;
+   }
+
+   for (k = 0; k < G_Objectives; k++)
+   {  c = lawrence_c + k * G_d;
+      Nv = 1 / det;
+      if (Nv < 0) Nv = - Nv;
+      for (i = 0; i < G_d && !job -> failed [k]; i++)
+         if (fabs (A [i] [G_d + k]) < EPSILON)
+            job -> failed [k] = TRUE;
+         else
+            Nv /= A [i] [G_d + k];
+
+      /* compute f(v) */
+      fv = lawrence_d;
+      for (i = 0; i < G_d; i++) fv += c [i] * job -> x [i];
+
+      for (i = 0; i < G_d; i++) Nv *= fv;
+      if (!job -> failed [k])
+         term [k] += Nv;
+   }
+}
+
+/****************************************************************************************/
+
+static rational factorise_cobasis (T_LawrenceJob *job, int s, int *subset)
+   /* writes the hyperplanes active [subset [0]] to active [subset [G_d-1]] (transposed), */
+   /* the objective functions, the vector job -> c and the remaining s - G_d hyperplanes  */
+   /* containing the vertex (transposed) to A and factorises it. The columns of the       */
+   /* remaining hyperplanes and of c then contain their coefficients in the basis given  */
+   /* by the cobasis. Returns the determinant of the cobasis.                            */
+
+{  int      i, j, p, column = G_d + G_Objectives + 1;
+   rational **A = job -> A;
+
+   for (p = 0; p < s; p++)
+      job -> row [p] = -1;
+   for (j = 0; j < G_d; j++)
+   {  job -> row [subset [j]] = j;
+      for (i = 0; i < G_d; i++)
+         A [i] [j] = G_Hyperplanes [job -> active [subset [j]]] [i];
+   }
+   set_objectives (A);
+   for (i = 0; i < G_d; i++)
+      A [i] [G_d + G_Objectives] = job -> c [i];
+   for (p = 0; p < s; p++)
+      if (job -> row [p] < 0)
+      {  job -> column [p] = column;
+         for (i = 0; i < G_d; i++)
+            A [i] [column] = G_Hyperplanes [job -> active [p]] [i];
+         column++;
+      }
+
+   return det_and_invert (A, G_d, column, FALSE);
+}
+
+/****************************************************************************************/
+
+static int lex_infeasible (T_LawrenceJob *job, int s)
+   /* returns the first hyperplane violated by the cobasis factorised by               */
+   /* "factorise_cobasis" under the perturbation of the right hand side of the p-th    */
+   /* hyperplane containing the vertex by eps^(p+1), or -1 if the cobasis is feasible. */
+   /* A hyperplane p outside the cobasis with a_p = sum lambda_r a_r is violated if    */
+   /* the first nonzero coefficient of eps^(p+1) - sum lambda_r eps^(r+1) is negative. */
+
+{  int p, r;
+
+   for (p = 0; p < s; p++)
+      if (job -> row [p] < 0)
+      {  /* the cobasis is sorted, so that the first nonzero lambda has the lowest index */
+         r = 0;
+         while (r < G_d && fabs (job -> A [r] [job -> column [p]]) < EPSILON)
+            r++;
+         if (r < G_d && job -> subset [r] < p && job -> A [r] [job -> column [p]] > 0)
+            return p;
+      }
+   return -1;
+}
+
+/****************************************************************************************/
+
+static void replace (int *subset, int r, int p)
+   /* replaces subset [r] by p, keeping the positions sorted */
+
+{  int i;
+
+   for (i = r; i < G_d - 1 && subset [i+1] < p; i++)
+      subset [i] = subset [i+1];
+   for (; i > 0 && subset [i-1] > p; i--)
+      subset [i] = subset [i-1];
+   subset [i] = p;
+}
+
+/****************************************************************************************/
+
+static rational pivot_tolerance (T_LawrenceJob *job, int p)
+   /* returns the tolerance below which the coefficients of hyperplane p outside the   */
+   /* cobasis are regarded as 0; it is relative to the biggest of them, since a pivot  */
+   /* which is small only by rounding errors leads to a singular cobasis               */
+
+{  int      r;
+   rational biggest = 0;
+
+   for (r = 0; r < G_d; r++)
+      if (fabs (job -> A [r] [job -> column [p]]) > biggest)
+         biggest = fabs (job -> A [r] [job -> column [p]]);
+   return (LEX_EPSILON * biggest > EPSILON ? LEX_EPSILON * biggest : EPSILON);
+}
+
+/****************************************************************************************/
+
+static boolean first_cobasis (T_LawrenceJob *job, int s)
+   /* finds a lexicographically feasible cobasis for the degenerate vertex and stores */
+   /* it in job -> subset. Starting with linearly independent hyperplanes chosen       */
+   /* greedily, c is set to the sum of their normals, so that the cobasis is feasible  */
+   /* for the dual problem min sum eps^(p+1) u_p, sum u_p a_p = c, u >= 0. The simplex  */
+   /* algorithm with Bland's rule then leads to an optimal cobasis, which is just a    */
+   /* lexicographically feasible one. Returns FALSE if rounding errors prevent this.   */
+
+{  int      i, j, p, r, leaving, found = 0;
+   rational **U = job -> A, norm, ratio, best = 0, tolerance;
+
+   /* choose the independent hyperplanes by orthogonalising them in the rows of A */
+   for (p = 0; p < s && found < G_d; p++)
+   {  for (i = 0; i < G_d; i++)
+         U [found] [i] = G_Hyperplanes [job -> active [p]] [i];
+      for (j = 0; j < found; j++)
+      {  norm = 0;
+         for (i = 0; i < G_d; i++)
+            norm += U [found] [i] * U [j] [i];
+         for (i = 0; i < G_d; i++)
+            U [found] [i] -= norm * U [j] [i];
+      }
+      norm = 0;
+      for (i = 0; i < G_d; i++)
+         norm += U [found] [i] * U [found] [i];
+      if (norm > EPSILON)
+      {  norm = sqrt (norm);
+         for (i = 0; i < G_d; i++)
+            U [found] [i] /= norm;
+         job -> subset [found++] = p;
+      }
+   }
+   for (i = 0; i < G_d; i++)
+   {  job -> c [i] = 0;
+      for (j = 0; j < G_d; j++)
+         job -> c [i] += G_Hyperplanes [job -> active [job -> subset [j]]] [i];
+   }
+
+   if (found < G_d || factorise_cobasis (job, s, job -> subset) == 0)
+      return FALSE;
+   while ((p = lex_infeasible (job, s)) >= 0)
+   {  /* p enters the cobasis; the leaving row is found by the ratio test, ties being */
+      /* broken by the lowest index                                                   */
+      leaving = -1;
+      tolerance = pivot_tolerance (job, p);
+      for (r = 0; r < G_d; r++)
+         if (job -> A [r] [job -> column [p]] > tolerance)
+         {  ratio = job -> A [r] [G_d + G_Objectives] / job -> A [r] [job -> column [p]];
+            if (leaving < 0 || ratio < best - EPSILON)
+            {  leaving = r;
+               best = ratio;
+            }
          }
-         k++;
+      if (leaving < 0)
+         /* the dual problem appears unbounded, which is impossible in exact arithmetic */
+         return FALSE;
+      replace (job -> subset, leaving, p);
+      if (factorise_cobasis (job, s, job -> subset) == 0)
+         return FALSE;
+   }
+   return TRUE;
+}
+
+/****************************************************************************************/
+
+static rational ratio_coefficient (T_LawrenceJob *job, int p, int r, int q)
+   /* returns the coefficient of eps^(q+1) in the ratio of the slack of hyperplane p   */
+   /* outside the cobasis and its decrease when leaving the hyperplane in row r of the */
+   /* cobasis                                                                          */
+
+{  rational lambda;
+
+   if (q == p)
+      lambda = -1;
+   else if (job -> row [q] >= 0)
+      lambda = job -> A [job -> row [q]] [job -> column [p]];
+   else
+      return 0;
+   return lambda / job -> A [r] [job -> column [p]];
+}
+
+/****************************************************************************************/
+
+static int entering (T_LawrenceJob *job, int s, int r)
+   /* returns the hyperplane entering the cobasis when the one in row r leaves it by    */
+   /* the lexicographic ratio test, or -1 if the corresponding edge is unbounded        */
+
+{  int      p, q, best = -1;
+   rational a, b;
+
+   for (p = 0; p < s; p++)
+      if (job -> row [p] < 0
+          && job -> A [r] [job -> column [p]] < - pivot_tolerance (job, p))
+      {  if (best < 0)
+            best = p;
+         else
+            for (q = 0; q < s; q++)
+            {  a = ratio_coefficient (job, p, r, q);
+               b = ratio_coefficient (job, best, r, q);
+               if (fabs (a - b) > EPSILON)
+               {  if (a < b)
+                     best = p;
+                  break;
+               }
+            }
       }
+   return best;
+}
 
-      if (j > G_d)
-      {  /* v is contained in at least dimension + 1 hyperplanes */
-         fprintf (stderr, "\n***** ERROR: Degenerated vertex in 'volume_lawrence':");
-         print_coords (stderr, vertices.loe [v]);
-         fprintf (stderr, "\n*** Planes containing the vertex:");
-         for (i = 0; i < G_m; i++)
-            if (is_in_hyperplane (vertices.loe [v], i))
-               fprintf (stderr, "\t%i", i + 1);
+/****************************************************************************************/
+
+static void add_cobasis (T_LawrenceJob *job, int *subset)
+   /* adds the cobasis to job -> bases if it is not yet contained in it */
+
+{  long int b;
+   int      r;
+
+   for (b = 0; b < job -> found; b++)
+   {  r = 0;
+      while (r < G_d && job -> bases [b * G_d + r] == subset [r])
+         r++;
+      if (r == G_d)
+         return;
+   }
+
+   if (job -> found == job -> max_found)
+   {  /* the statistics are updated by "account_bases" after the threads have finished */
+      job -> bases = (int *) realloc (job -> bases, 2 * job -> max_found * G_d * sizeof (int));
+      if (job -> bases == NULL)
+      {  fprintf (stderr, "\n***** ERROR: Out of memory in 'add_cobasis'.\n");
          exit (0);
       }
+      job -> max_found *= 2;
+   }
+   for (r = 0; r < G_d; r++)
+      job -> bases [job -> found * G_d + r] = subset [r];
+   job -> found++;
+}
+
+/****************************************************************************************/
+
+static void degenerate_summands (T_LawrenceJob *job, int s, rational *term, rational *low)
+   /* computes the summands of Lawrence's formula for the degenerate vertex job -> x   */
+   /* contained in the s hyperplanes job -> active. Under a lexicographic perturbation */
+   /* of the right hand sides, the vertex splits into simple vertices, which are the   */
+   /* lexicographically feasible cobases among the subsets of G_d of the hyperplanes;  */
+   /* their summands are added to term (and low). The first of them is found by      */
+   /* "first_cobasis", the others by pivoting along the edges between them.            */
+
+{  int      i, k, r, p, *subset = job -> subset;
+   long int b;
+   rational det;
+
+   if (!job -> extended)
+      job -> degenerate++;
+   if (!first_cobasis (job, s))
+   {  /* reported as a division by zero */
+      for (k = 0; k < G_Objectives; k++)
+         job -> failed [k] = TRUE;
+      return;
+   }
+
+   job -> found = 0;
+   add_cobasis (job, subset);
+   for (b = 0; b < job -> found; b++)
+   {  for (r = 0; r < G_d; r++)
+         subset [r] = job -> bases [b * G_d + r];
+      det = factorise_cobasis (job, s, subset);
+      for (r = 0; r < G_d; r++)
+         job -> normal [r] = G_Hyperplanes [job -> active [subset [r]]];
+      add_summands (job, det, term, low);
+      if (!job -> extended)
+         job -> cobases++;
+
+      for (r = 0; r < G_d; r++)
+         if ((p = entering (job, s, r)) >= 0)
+         {  for (i = 0; i < G_d; i++)
+               subset [i] = job -> bases [b * G_d + i];
+            replace (subset, r, p);
+            add_cobasis (job, subset);
+         }
+   }
+}
+
+/****************************************************************************************/
+
+static void *lawrence_terms (void *job)
+   /* computes the summands of Lawrence's formula for the vertices first to last - 1 of */
+   /* the job; the threads only read the polytope and write disjoint parts of          */
+   /* lawrence_term, lawrence_low and lawrence_redo. The memory for the cobases of the */
+   /* degenerate vertices is allocated per thread and accounted for afterwards by      */
+   /* "account_bases". In extended precision, only the vertices marked in              */
+   /* lawrence_redo are treated.                                                       */
+
+{  int           v, i, j, k, s;
+   T_LawrenceJob *data = (T_LawrenceJob *) job;
+   rational      **A = data -> A, *term, *low = NULL;
+   boolean       *incident;
+
+   for (v = data -> first; v < data -> last; v++)
+   {  if (data -> extended)
+      {  if (lawrence_redo [v] != 1)
+            continue;
+         lawrence_redo [v] = 2;
+      }
+      term = lawrence_term + v * G_Objectives;
+      if (lawrence_low != NULL)
+         low = lawrence_low + v * G_Objectives;
+      for (k = 0; k < G_Objectives; k++)
+      {  term [k] = 0;
+         if (low != NULL)
+            low [k] = 0;
+      }
+      data -> x = lawrence_vertices.loe [v] -> coords;
+
+      /* find the binding constraints for vertex v */
+      incident = G_Incidence [lawrence_vertices.loe [v] -> no];
+      s = 0;
+      for (k = 0; k < G_m; k++)
+         if (incident [k])
+            data -> active [s++] = k;
+
+      if (s == G_d)
+      {  /* write them (transposed!) in A */
+         for (j = 0; j < G_d; j++)
+         {  data -> normal [j] = G_Hyperplanes [data -> active [j]];
+            for (i = 0; i < G_d; i++)
+               A [i] [j] = G_Hyperplanes [data -> active [j]] [i];
+         }
+         set_objectives (A);
+         add_summands (data, det_and_invert (A, G_d, G_d + G_Objectives, TRUE), term, low);
+      }
+      else if (s > G_d)
+         /* v is contained in at least dimension + 1 hyperplanes */
+         degenerate_summands (data, s, term, low);
       else
-      {
-         for (i = 0; i < G_d; i++) A [i] [G_d] = c [i];
+      {  fprintf (stderr, "\n***** ERROR: Vertex in only %i hyperplanes in 'volume_lawrence':", s);
+         print_coords (stderr, lawrence_vertices.loe [v]);
+         exit (0);
+      }
+   }
 
-         Nv = 1 / det_and_invert (A, G_d, G_d + 1, TRUE);
-         if (Nv < 0) Nv = - Nv;
-         for (i = 0; i < G_d; i++)
-           if (fabs (A [i] [G_d]) < EPSILON)
-           {  fprintf (stderr, "\n***** ERROR: Division by zero (");
-              fprintf (stderr, "%e) in 'volume_lawrence'.", (real) A [i] [G_d]);
-              exit (0);
-           }
-           else Nv /= A [i] [G_d];
-
-         /* compute f(v) */
-         fv = d;
-         for (i = 0; i < G_d; i++) fv += c [i] * vertices.loe [v] -> coords [i];
-      
-         for (i = 0; i < G_d; i++) Nv *= fv;
+   return NULL;
+}
+
+/****************************************************************************************/
+
+static void *lrs_terms (void *job)
+   /* computes the summands of Lawrence's formula for the cobases first to last - 1 of  */
+   /* the job in lawrence_cobasis                                                       */
+
+{  int           v, i, j, k, *cobasis;
+   T_LawrenceJob *data = (T_LawrenceJob *) job;
+   rational      **A = data -> A, *x = data -> x, *term, *low = NULL;
+
+   for (v = data -> first; v < data -> last; v++)
+   {  cobasis = lawrence_cobasis + v * G_d;
+      term = lawrence_term + v * G_Objectives;
+      if (lawrence_low != NULL)
+         low = lawrence_low + v * G_Objectives;
+      for (k = 0; k < G_Objectives; k++)
+      {  term [k] = 0;
+         if (low != NULL)
+            low [k] = 0;
+      }
+
+      if (data -> extended)
+      {  /* the vertex is computed together with the summands */
+         for (j = 0; j < G_d; j++)
+            data -> normal [j] = G_Hyperplanes [cobasis [j]];
+         extended_summands (data -> normal, NULL, lawrence_c, lawrence_d, term, low,
+                            data -> failed, data -> work);
+         continue;
+      }
+
+      /* copy binding restrictions and b to A and compute the vertex */
+      for (i = 0; i < G_d; i++)
+        for (j = 0; j <= G_d; j++) A [i] [j] = G_Hyperplanes [cobasis [i]] [j];
+      det_and_invert (A, G_d, G_d + 1, TRUE);
+      for (i = 0; i < G_d; i++)
+         x [i] = A [i] [G_d];
+         /* column "dimension" of A contains vertex coordinates */
+
+      /* copy binding restrictions (transposed) and c to A */
+      for (i = 0; i < G_d; i++)
+         for (j = 0; j < G_d; j++) A [i] [j] = G_Hyperplanes [cobasis [j]] [i];
+      set_objectives (A);
+
+      add_summands (data, det_and_invert (A, G_d, G_d + G_Objectives, TRUE), term, low);
+   }
+
+   return NULL;
+}
+
+/****************************************************************************************/
+
+static T_LawrenceJob *create_jobs (int threads, boolean lrs)
+   /* creates the data of the threads; with lrs, each thread gets a vector for the     */
+   /* vertex coordinates, otherwise the data for splitting degenerate vertices        */
+
+{  int           t, k;
+   T_LawrenceJob *job = (T_LawrenceJob *) my_malloc (threads * sizeof (T_LawrenceJob));
+
+   for (t = 0; t < threads; t++)
+   {  job [t].columns = G_d + G_Objectives + (lrs ? 0 : G_m + 1);
+      job [t].A = create_matrix (G_d, job [t].columns);
+      job [t].x = (lrs ? create_vector () : NULL);
+      job [t].failed = (boolean *) my_malloc (G_Objectives * sizeof (boolean));
+      for (k = 0; k < G_Objectives; k++)
+         job [t].failed [k] = FALSE;
+      if (!lrs)
+      {  job [t].active = create_int_vector (G_m);
+         job [t].subset = create_int_vector (G_d);
+         job [t].row = create_int_vector (G_m);
+         job [t].column = create_int_vector (G_m);
+         job [t].c = create_vector ();
+         job [t].max_found = 64;
+         job [t].accounted = job [t].max_found;
+         job [t].bases = create_int_vector (job [t].max_found * G_d);
       }
+      job [t].degenerate = 0;
+      job [t].cobases = 0;
+      job [t].extended = (lrs && G_Precision != PRECISION_DOUBLE);
+      job [t].normal = (real **) my_malloc (G_d * sizeof (real *));
+      job [t].work = (G_Precision != PRECISION_DOUBLE ? create_extended_work () : NULL);
+   }
+   return job;
+}
+
+/****************************************************************************************/
+
+static void free_jobs (T_LawrenceJob *job, int threads, boolean lrs)
+   /* frees the data created by "create_jobs" */
+
+{  int t;
+
+   for (t = 0; t < threads; t++)
+   {  free_matrix (job [t].A, G_d, job [t].columns);
+      if (lrs)
+         free_vector (job [t].x);
+      else
+      {  free_int_vector (job [t].active, G_m);
+         free_int_vector (job [t].subset, G_d);
+         free_int_vector (job [t].row, G_m);
+         free_int_vector (job [t].column, G_m);
+         free_vector (job [t].c);
+         free_int_vector (job [t].bases, job [t].max_found * G_d);
+      }
+      my_free (job [t].failed, G_Objectives * sizeof (boolean));
+      my_free (job [t].normal, G_d * sizeof (real *));
+      if (job [t].work != NULL)
+         free_extended_work (job [t].work);
+   }
+   my_free (job, threads * sizeof (T_LawrenceJob));
+}
+
+/****************************************************************************************/
+
+static void run_threads (void *(*terms) (void *), T_LawrenceJob *job, int threads, int n)
+   /* computes the summands 0 to n-1 by the function terms, splitting them into        */
+   /* contiguous ranges for the given number of threads                                */
+
+{  int t;
+
+   for (t = 0; t < threads; t++)
+   {  job [t].first = (int) ((long int) n * t / threads);
+      job [t].last = (int) ((long int) n * (t + 1) / threads);
+   }
+   run_jobs (terms, job, sizeof (T_LawrenceJob), threads);
+}
+
+/****************************************************************************************/
+
+static void account_bases (T_LawrenceJob *job, int threads)
+   /* adds the memory by which the threads have enlarged their cobases to the          */
+   /* statistics                                                                       */
+
+{  int t;
+
+   for (t = 0; t < threads; t++)
+   {  account_memory ((job [t].max_found - job [t].accounted) * G_d * sizeof (int));
+      job [t].accounted = job [t].max_found;
+   }
+}
+
+/****************************************************************************************/
+
+static void add_terms (int n, rational *sum, rational *compensation, rational *absolute,
+   boolean statistics)
+   /* adds the summands 0 to n-1 for each objective function k in their order to       */
+   /* sum [k] by the compensated summation of Neumaier, accumulating the rounding      */
+   /* errors in compensation [k]; this way the result does not depend on the number of */
+   /* threads, and the cancellation between the summands of opposite signs costs less  */
+   /* accuracy. absolute [k] sums the absolute values of the summands.                 */
+   /* In extended precision, sum [k] + compensation [k] is a double-double number to    */
+   /* which the summands are added exactly instead.                                    */
+   /* If statistics is TRUE, they are kept for the first objective function; it is     */
+   /* FALSE when the same summands are added once more in extended precision.           */
+
+{  int      v, k;
+   rational total, term;
+
+   for (v = 0; v < n; v++)
+   {
 #ifdef STATISTICS
-      update_statistics (Nv);
+      if (statistics)
+         update_statistics (lawrence_term [v * G_Objectives]);
 #endif
-      (*volume) += Nv;
+      for (k = 0; k < G_Objectives; k++)
+      {  term = lawrence_term [v * G_Objectives + k];
+         absolute [k] += fabs (term);
+         if (lawrence_low != NULL)
+         {  extended_add (&(sum [k]), &(compensation [k]), term,
+                          lawrence_low [v * G_Objectives + k]);
+            continue;
+         }
+         total = sum [k] + term;
+         if (fabs (sum [k]) >= fabs (term))
+            compensation [k] += (sum [k] - total) + term;
+         else
+            compensation [k] += (term - total) + sum [k];
+         sum [k] = total;
+      }
    }
-   (*volume) /= factorial (G_d);
+}
+
+/****************************************************************************************/
+
+static rational select_objective (T_LawrenceJob *job, int threads, rational *sum,
+   rational *compensation, rational *absolute)
+   /* returns the sum of Lawrence's formula for the objective function with the        */
+   /* smallest cancellation, measured by the ratio of the sum of the absolute values   */
+   /* of the summands to the absolute value of their sum, among those without division */
+   /* by zero. For several objective functions, all results are printed.               */
+
+{  int      k, t, best = -1;
+   boolean  failed;
+   rational value, condition, best_condition = 0;
+
+   if (G_Objectives > 1)
+      printf ("\nobjective            volume     cancellation");
+   for (k = 0; k < G_Objectives; k++)
+   {  failed = FALSE;
+      for (t = 0; t < threads; t++)
+         failed = failed || job [t].failed [k];
+      value = sum [k] + compensation [k];
+      condition = (value != 0 ? absolute [k] / fabs (value) : 1e99);
+      if (G_Objectives > 1)
+      {  if (failed)
+            printf ("\n%9i    division by zero", k + 1);
+         else
+            printf ("\n%9i %20.12e %12.2e", k + 1, value / factorial (G_d), condition);
+      }
+      if (!failed && (best == -1 || condition < best_condition))
+      {  best = k;
+         best_condition = condition;
+      }
+   }
+
+   if (best == -1)
+   {  fprintf (stderr, "\n***** ERROR: Division by zero for all objective functions in ");
+      fprintf (stderr, "'volume_lawrence';\n      try other ones with the options -r or -k.");
+      fprintf (stderr, "\n      If a degenerate vertex could not be split because of rounding");
+      fprintf (stderr, "\n      errors, another method is needed.\n");
+      exit (0);
+   }
+   if (G_Objectives > 1)
+      printf ("\nThe objective function c_%i is chosen.\n", best + 1);
+   return sum [best] + compensation [best];
+}
+
+/****************************************************************************************/
 
-   free_matrix (A, G_d, G_d + 1);
-   free_vector (c);
+static long int mark_summands (int n, rational *sum, rational *compensation)
+   /* marks the vertices in lawrence_redo whose summands, computed in double precision, */
+   /* have an estimated rounding error above LAWRENCE_ACCURACY times the absolute value */
+   /* of the current sum divided by n, and returns their number                         */
+
+{  int      v, k;
+   long int count = 0;
+   rational error = 4.0 * G_d * G_d * DBL_EPSILON * n;
+
+   for (v = 0; v < n; v++)
+      if (lawrence_redo [v] == 0)
+         for (k = 0; k < G_Objectives; k++)
+            if (fabs (lawrence_term [v * G_Objectives + k]) * error
+                > LAWRENCE_ACCURACY * fabs (sum [k] + compensation [k]))
+            {  lawrence_redo [v] = 1;
+               count++;
+               break;
+            }
+   return count;
+}
+
+/****************************************************************************************/
+
+static void volume_lawrence_set (T_VertexSet vertices, rational *volume)
+   /* The summands are computed by G_Threads threads, each of which treats a contiguous */
+   /* range of vertices, and then added in the order of the vertices.                   */
+   /* In extended precision, the summands are first computed in double precision; those */
+   /* which are too big compared to their sum are then recomputed, and since the sum    */
+   /* becomes more accurate, this is repeated until no more summands are concerned.     */
+
+{  int           k, t, n = vertices.lastel + 1, threads = G_Threads;
+   long int      count, extended = 0;
+   rational      *sum, *compensation, *absolute;
+   T_LawrenceJob *job;
+
+   lawrence_vertices = vertices;
+   lawrence_c = (rational *) my_malloc (G_Objectives * G_d * sizeof (rational));
+   determine_c_and_d (lawrence_c, &lawrence_d);
+   lawrence_term = (rational *) my_malloc ((long int) n * G_Objectives * sizeof (rational));
+   sum = (rational *) my_malloc (3 * G_Objectives * sizeof (rational));
+   compensation = sum + G_Objectives;
+   absolute = compensation + G_Objectives;
+   for (k = 0; k < 3 * G_Objectives; k++)
+      sum [k] = 0;
+
+   if (threads > n)
+      threads = n;
+   job = create_jobs (threads, FALSE);
+
+   run_threads (lawrence_terms, job, threads, n);
+   account_bases (job, threads);
+   if (G_Precision != PRECISION_DOUBLE)
+   {  lawrence_low = (rational *) my_malloc ((long int) n * G_Objectives * sizeof (rational));
+      lawrence_redo = create_int_vector (n);
+      for (k = 0; k < n * G_Objectives; k++)
+         lawrence_low [k] = 0;
+      for (k = 0; k < n; k++)
+         lawrence_redo [k] = 0;
+      for (t = 0; t < threads; t++)
+         job [t].extended = TRUE;
+      for (;;)
+      {  for (k = 0; k < 3 * G_Objectives; k++)
+            sum [k] = 0;
+         add_terms (n, sum, compensation, absolute, extended == 0);
+         if ((count = mark_summands (n, sum, compensation)) == 0)
+            break;
+         extended += count;
+         run_threads (lawrence_terms, job, threads, n);
+         account_bases (job, threads);
+      }
+      printf ("\nThe summands of %li of %i vertices have been computed in extended precision.\n",
+              extended, n);
+      free_int_vector (lawrence_redo, n);
+      my_free (lawrence_low, (long int) n * G_Objectives * sizeof (rational));
+      lawrence_low = NULL;
+   }
+   else
+      add_terms (n, sum, compensation, absolute, TRUE);
+   for (t = 1; t < threads; t++)
+   {  job [0].degenerate += job [t].degenerate;
+      job [0].cobases += job [t].cobases;
+   }
+   if (job [0].degenerate > 0)
+      printf ("\n%li degenerate vertices have been split into %li simple ones.\n",
+              job [0].degenerate, job [0].cobases);
+   (*volume) = select_objective (job, threads, sum, compensation, absolute)
+               / factorial (G_d);
+
+   free_jobs (job, threads, FALSE);
+   my_free (sum, 3 * G_Objectives * sizeof (rational));
+   my_free (lawrence_term, (long int) n * G_Objectives * sizeof (rational));
+   my_free (lawrence_c, G_Objectives * G_d * sizeof (rational));
 }
 
 /****************************************************************************************/
@@ -418,9 +2228,7 @@ static void volume_lawrence_set (T_VertexSet vertices, rational *volume)
 void volume_lawrence_file (rational *volume, char *vertexfile, char *planesfile)
 
 {
-   read_vertices (vertexfile);
-   read_hyperplanes (planesfile);
-   compute_incidence ();
+   read_polytope (vertexfile, planesfile);
    volume_lawrence_set (G_Vertices, volume);
    free_hyperplanes ();
    free_incidence ();
@@ -430,109 +2238,162 @@ void volume_lawrence_file (rational *volume, char *vertexfile, char *planesfile)
 /****************************************************************************************/
 /****************************************************************************************/
 
-void volume_lawrence_lrs_file (rational *volume, char *planesfile)
+static int next_cobases (FILE *f, boolean binary)
+   /* reads up to LRS_BATCH cobases into lawrence_cobasis and returns their number, 0 */
+   /* at the end; f is either the output of lrs or a cobasis file                      */
 
-{  FILE     *f;
-   int      i, j;
-   int      *cobasis;
-   rational **A, *c, d;
-   rational Nv, fv;
-   char     line [255], system_command [255], *pos;
-   char     *tmp_file, tmp_file_1 [255], tmp_file_2 [255];
-
-   /* Temporary files are stored in the same directory as the executable with the same  */
-   /* base name as the planesfile.                                                      */
-   tmp_file = strrchr (planesfile, '/');
-   if (tmp_file == NULL)
-      tmp_file = planesfile;
-   else
-      tmp_file ++;
-
-   /* copy the planes file to the temporary file planesfile+".li.tmp" */
-   sprintf (tmp_file_1, "%s.li.tmp", tmp_file);
-   sprintf (tmp_file_2, "%s.lo.tmp", tmp_file);
-   sprintf (system_command, "cp %s %s", planesfile, tmp_file_1);
-   system (system_command);
-   sprintf (system_command, "chmod a+w %s", tmp_file_1);
-   system (system_command);
-   sprintf (system_command, "echo >> %s", tmp_file_1);
-   system (system_command);
-   sprintf (system_command, "echo printcobasis >> %s", tmp_file_1);
-   system (system_command);
-
-   /* call lrs */
-   printf ("\nRunning 'lrs'.");
-   sprintf (system_command, "%s < %s > %s", LRS_EXEC, tmp_file_1, tmp_file_2);
-   system (system_command);
+{  int  i, n = 0;
+   char line [255], *pos;
 
-   /* prepare variables */
-   read_hyperplanes (tmp_file_1);
-   A = create_matrix (G_d, G_d + 1);
-   c = create_vector ();
-   cobasis = create_int_vector (G_d);
-   (*volume) = 0;
-   determine_c_and_d (c, &d);
-
-   /* determine all feasible cobases from the output of lrs */
-   f = open_read (tmp_file_2);
-   fscanf (f, "***** %*i %*s ");
-   /* read lines until EOF */
-   while (fgets (line, 255, f) != NULL)
-   {
-      /* look for string 'facets' in line */
+   if (binary)
+      return fread (lawrence_cobasis, G_d * sizeof (int), LRS_BATCH, f);
+
+   while (n < LRS_BATCH && fgets (line, 255, f) != NULL)
+   {  /* look for string 'facets' in line */
       pos = strstr (line, "facets  ");
       if (pos != NULL)
       {  pos += 8;
          for (i = 0; i < G_d; i++)
-         {  sscanf (pos, "%i", & (cobasis [i]));
-            cobasis [i] -= 1;
+         {  sscanf (pos, "%i", &(lawrence_cobasis [n * G_d + i]));
+            lawrence_cobasis [n * G_d + i] -= 1;
             pos = strpbrk (pos, " ") + 1;
          }
-         /* cobasis has been read in */
-
-         /* copy binding restrictions (transposed) and c to A */
-         for (i = 0; i < G_d; i++)
-         {  for (j = 0; j < G_d; j++) A [i] [j] = G_Hyperplanes [cobasis [j]] [i];
-            A [i] [G_d] = c [i];
-         }
+         n++;
+      }
+   }
+   return n;
+}
 
-         /* compute denominator of Nv */
-         Nv = 1 / det_and_invert (A, G_d, G_d + 1, TRUE);
-         if (Nv < 0) Nv = -Nv;
-         for (i = 0; i < G_d; i++)
-           if (fabs (A [i] [G_d]) < EPSILON)
-           {  fprintf (stderr, "\n***** ERROR: Division by zero (");
-              fprintf (stderr, "%e) in 'volume_lawrence_lrs_file'", (real) A [i] [G_d]);
-              exit (0);
-           }
-           else Nv /= A [i] [G_d];
-
-         /* copy binding restrictions and b to A */
-         for (i = 0; i < G_d; i++)
-           for (j = 0; j <= G_d; j++) A [i] [j] = G_Hyperplanes [cobasis [i]] [j];
-         det_and_invert (A, G_d, G_d + 1, TRUE);
+/****************************************************************************************/
 
-         /* compute f(v) */
-         fv = d;
-         for (i = 0; i < G_d; i++) fv += c [i] * A [i] [G_d];
-            /* column "dimension" of A contains vertex coordinates */
+static FILE *open_cobases (char *filename, unsigned long int hash, long int *count)
+   /* opens the cobasis file and returns it positioned at the first cobasis if it has  */
+   /* been completed for a planes file with the given hash value and the actual        */
+   /* dimensions; otherwise NULL is returned. count contains the number of cobases.    */
+
+{  FILE              *f;
+   char              magic [8];
+   unsigned long int file_hash;
+   int               d, m;
+
+   if (! (f = fopen (filename, "rb")))
+      return NULL;
+   if (fread (magic, 1, 8, f) != 8 || strncmp (magic, "VINCICB1", 8)
+       || fread (&file_hash, sizeof (unsigned long int), 1, f) != 1 || file_hash != hash
+       || fread (&d, sizeof (int), 1, f) != 1 || d != G_d
+       || fread (&m, sizeof (int), 1, f) != 1 || m != G_m
+       || fread (count, sizeof (long int), 1, f) != 1 || *count < 0)
+   {  fclose (f);
+      return NULL;
+   }
+   return f;
+}
 
-         for (i = 0; i < G_d; i++) Nv *= fv;
+/****************************************************************************************/
 
-#ifdef STATISTICS
-         update_statistics (Nv);
-#endif
+void volume_lawrence_lrs_file (rational *volume, char *planesfile)
+   /* The feasible cobases are read from the output of lrs while it is still running;  */
+   /* whenever LRS_BATCH of them have been collected, their summands are computed by   */
+   /* G_Threads threads as in "volume_lawrence_set".                                    */
+   /* The cobases are written to a file with extension '.cob' next to the planes file, */
+   /* starting with "VINCICB1", the hash value of the planes file as unsigned long int,*/
+   /* the dimension and the number of hyperplanes as int and the number of cobases as  */
+   /* long int, followed by the cobases as int. The number is -1 until all cobases are */
+   /* written. If the file belongs to the actual planes file, the cobases are read from */
+   /* it instead of running lrs, so that other objective functions are cheap to try.   */
+
+{  FILE              *f, *cob;
+   int               k, n, threads = G_Threads;
+   long int          count = 0, stored = -1;
+   unsigned long int hash;
+   rational          *sum, *compensation, *absolute;
+   char              cobfile [255];
+   boolean           cached;
+   T_LawrenceJob     *job;
 
-         (*volume) += Nv;
+   /* prepare variables */
+   read_hyperplanes (planesfile);
+   lawrence_c = (rational *) my_malloc (G_Objectives * G_d * sizeof (rational));
+   determine_c_and_d (lawrence_c, &lawrence_d);
+   lawrence_cobasis = create_int_vector (LRS_BATCH * G_d);
+   lawrence_term = (rational *) my_malloc (LRS_BATCH * G_Objectives * sizeof (rational));
+   if (G_Precision != PRECISION_DOUBLE)
+      lawrence_low = (rational *) my_malloc (LRS_BATCH * G_Objectives * sizeof (rational));
+   sum = (rational *) my_malloc (3 * G_Objectives * sizeof (rational));
+   compensation = sum + G_Objectives;
+   absolute = compensation + G_Objectives;
+   for (k = 0; k < 3 * G_Objectives; k++)
+      sum [k] = 0;
+   job = create_jobs (threads, TRUE);
+
+   /* the planes file name ends with '.ine' */
+   strcpy (cobfile, planesfile);
+   strcpy (cobfile + strlen (cobfile) - 4, ".cob");
+   hash = hash_file (planesfile);
+   cob = open_cobases (cobfile, hash, &stored);
+   cached = (cob != NULL);
+
+   if (cached)
+   {  printf ("\nReading %li cobases from '%s'.", stored, cobfile);
+      f = cob;
+   }
+   else
+   {  /* call lrs */
+      printf ("\nRunning 'lrs'.");
+      f = open_lrs (planesfile, NULL, "\nprintcobasis\n");
+      fscanf (f, "***** %*i %*s ");
+      if ((cob = fopen (cobfile, "wb")))
+      {  fwrite ("VINCICB1", 1, 8, cob);
+         fwrite (&hash, sizeof (unsigned long int), 1, cob);
+         fwrite (&G_d, sizeof (int), 1, cob);
+         fwrite (&G_m, sizeof (int), 1, cob);
+         fwrite (&stored, sizeof (long int), 1, cob);
       }
+      else
+         printf ("\nThe cobases cannot be stored in '%s'.", cobfile);
    }
-   fclose (f);
-   (*volume) /= factorial (G_d);
 
+   /* determine all feasible cobases and evaluate them batch by batch */
+   while ((n = next_cobases (f, cached)) > 0)
+   {  if (!cached && cob != NULL)
+         fwrite (lawrence_cobasis, G_d * sizeof (int), n, cob);
+      run_threads (lrs_terms, job, threads, n);
+      add_terms (n, sum, compensation, absolute, TRUE);
+      count += n;
+   }
+
+   if (cached)
+   {  fclose (cob);
+      if (count != stored)
+      {  fprintf (stderr, "\n***** ERROR: The file '%s' contains only %li of %li cobases.\n",
+                  cobfile, count, stored);
+         exit (0);
+      }
+   }
+   else
+   {  if (!close_lrs (f))
+         printf ("\n'lrs' has not terminated normally; the cobases are not stored.");
+      else if (cob != NULL)
+      {  /* mark the file as complete */
+         fseek (cob, 8 + sizeof (unsigned long int) + 2 * sizeof (int), SEEK_SET);
+         fwrite (&count, sizeof (long int), 1, cob);
+      }
+      if (cob != NULL)
+         fclose (cob);
+   }
+   (*volume) = select_objective (job, threads, sum, compensation, absolute)
+               / factorial (G_d);
+
+   free_jobs (job, threads, TRUE);
+   my_free (sum, 3 * G_Objectives * sizeof (rational));
+   my_free (lawrence_term, LRS_BATCH * G_Objectives * sizeof (rational));
+   if (lawrence_low != NULL)
+   {  my_free (lawrence_low, LRS_BATCH * G_Objectives * sizeof (rational));
+      lawrence_low = NULL;
+   }
+   free_int_vector (lawrence_cobasis, LRS_BATCH * G_d);
+   my_free (lawrence_c, G_Objectives * G_d * sizeof (rational));
    free_hyperplanes ();
-   free_int_vector (cobasis, G_d);
-   free_matrix (A, G_d, G_d + 1);
-   free_vector (c);
 }
 
 /****************************************************************************************/
@@ -544,46 +2405,23 @@ void volume_lrs_file (rational *volume, char *rational_volume, char *vertexfile)
    /* interior contains the origin; thus the returned volume is wrong in these cases.   */
    /* rational_volume contains the volume output of lrs in form of a string.            */
 
-{  FILE    *f1, *f2;
-   char    line [255], system_command [255], *pos = NULL;
-   char    *tmp_file, tmp_file_1 [255], tmp_file_2 [255];
+{  FILE    *f;
+   char    line [255], *pos = NULL;
    boolean volume_found = FALSE;
 
-   /* Temporary files are stored in the same directory as the executable with the same  */
-   /* base name as the vertexfile.                                                      */
-   tmp_file = strrchr (vertexfile, '/');
-   if (tmp_file == NULL)
-      tmp_file = vertexfile;
-   else
-      tmp_file ++;
-
-   /* copy the vertex file to vertexfile+".li.tmp"; at the same time, add needed lines  */
-   sprintf (tmp_file_1, "%s.li.tmp", tmp_file);
-   sprintf (tmp_file_2, "%s.lo.tmp", tmp_file);
-   f1 = open_read (vertexfile);
-   f2 = fopen (tmp_file_1, "w");
-   fprintf (f2, "*\nV-representation\nbegin\n");
-   while (fgets (line, 255, f1) != NULL && strncmp (line, "end", 3))
-      fprintf (f2, "%s", line);
-   fprintf (f2, "end\nvolume\n");
-   fclose (f1);
-   fclose (f2);
-
-   /* call lrs */
+   /* call lrs on the vertices of the file, adding the needed lines */
    printf ("\nRunning 'lrs'.");
-   sprintf (system_command, "%s < %s > %s", LRS_EXEC, tmp_file_1, tmp_file_2);
-   system (system_command);
+   f = open_lrs (vertexfile, "*\nV-representation\nbegin\n", "end\nvolume\n");
 
    /* search for the volume in the output */
-   f1 = open_read (tmp_file_2);
-   while (fgets (line, 255, f1) != NULL)
+   while (fgets (line, 255, f) != NULL)
    {  pos = strstr (line, "*Volume=");
       if (pos != NULL)
       {  volume_found = TRUE;
          break;
       }
    }
-   fclose (f1);
+   close_lrs (f);
 
    if (volume_found)
    {  pos += 8; /* pos now points to the volume */